@@ -8,13 +8,6 @@
 
 #include "include/Application.hpp"
 
-/* ************************************************************************************************
- * Global Variable
- * ************************************************************************************************
- */
-int Application::appCount = 0;
-
-
 /** ===============================================================================================
  * \name    Application
  * 
@@ -35,7 +28,7 @@ int Application::appCount = 0;
  */
 Application::Application(char* model_type, vector<int> input_size, int batch_size, unsigned long long arrival_time
                                     , unsigned long long  period /* , unsigned long long deadline */, unsigned long long end_time)
-    : appID(appCount++), modelType(model_type), inputSize(input_size), batchSize(batch_size), arrivalTime(arrival_time), period(period)
+    : appID(sim_context->app_count++), modelType(model_type), inputSize(input_size), batchSize(batch_size), arrivalTime(arrival_time), period(period)
     /* , deadline(deadline) */, endTime(end_time), SM_budget({}), modelInfo(Model::getModelInfo(model_type)), finish(false)
 {
     ASSERT(input_size[BATCH] == 1, "Dimension error");
@@ -15,11 +15,12 @@
  * 
  * \param   mc      the pointer of memory controller
  * \param   gpu     the pointer of GPU
+ * \param   apps    the applications placed on the GPU by the NodeScheduler
  * 
  * \endcond
  * ================================================================================================
  */
-CPU::CPU(MemoryController* mc, GPU* gpu) : mMC(mc), mGPU(gpu), mMMU(MMU(mc))
+CPU::CPU(MemoryController* mc, GPU* gpu, const vector<Application*>& apps) : mMC(mc), mGPU(gpu), mMMU(MMU(mc)), mAPPs(apps)
 {
     /* *******************************************************************
      * Select scheduler
@@ -33,108 +34,6 @@ CPU::CPU(MemoryController* mc, GPU* gpu) : mMC(mc), mGPU(gpu), mMMU(MMU(mc))
 
     else if (command.SCHEDULER_MODE == SALBI)   mScheduler = new Scheduler_SALBI(this);
 
-    /* *******************************************************************
-     * Create applications
-     * *******************************************************************
-     */
-    for (auto& task : command.TASK_LIST)
-    {
-        if (task.first == APPLICATION::LeNet)
-        {
-            mAPPs.push_back(new Application ((char*)"LeNet"
-                , {1, 1, 32, 32}
-                , get<0>(task.second)                   // batch size
-                , get<1>(task.second) * GPU_F / 1000    // arrival time
-                , get<2>(task.second) * GPU_F / 1000    // period
-                // , get<3>(task.second) * GPU_F / 1000    //dead;ome
-                , GPU_F * SIMULATION_TIME / 1000
-            ));
-        }
-        else if (task.first == APPLICATION::CaffeNet)
-        {
-            mAPPs.push_back(new Application ((char*)"CaffeNet"
-                , {1, 3, 112, 112}
-                , get<0>(task.second)                   // batch size
-                , get<1>(task.second) * GPU_F / 1000    // arrival time
-                , get<2>(task.second) * GPU_F / 1000    // period
-                // , get<3>(task.second) * GPU_F / 1000     //dead;ome
-                , GPU_F * SIMULATION_TIME / 1000
-            ));
-        }
-        else if (task.first == APPLICATION::ResNet18)
-        {
-            mAPPs.push_back(new Application ((char*)"ResNet18"
-                , {1, 3, 112, 112}
-                , get<0>(task.second)                   // batch size
-                , get<1>(task.second) * GPU_F / 1000    // arrival time
-                , get<2>(task.second) * GPU_F / 1000    // period
-                // , get<3>(task.second) * GPU_F / 1000     //dead;ome
-                , GPU_F * SIMULATION_TIME / 1000
-            ));
-        }
-        else if (task.first == APPLICATION::GoogleNet)
-        {
-            mAPPs.push_back(new Application ((char*)"GoogleNet"
-                , {1, 3, 112, 112}
-                , get<0>(task.second)                   // batch size
-                , get<1>(task.second) * GPU_F / 1000    // arrival time
-                , get<2>(task.second) * GPU_F / 1000    // period
-                // , get<3>(task.second) * GPU_F / 1000    //dead;ome
-                , GPU_F * SIMULATION_TIME / 1000
-            ));
-        }
-        else if (task.first == APPLICATION::VGG16)
-        {
-            mAPPs.push_back(new Application ((char*)"VGG16"
-                , {1, 3, 112, 112}
-                , get<0>(task.second)                   // batch size
-                , get<1>(task.second) * GPU_F / 1000    // arrival time
-                , get<2>(task.second) * GPU_F / 1000    // period
-                // , get<3>(task.second) * GPU_F / 1000    //dead;ome
-                , GPU_F * SIMULATION_TIME / 1000
-            ));
-        }
-        else if (task.first == APPLICATION::SqueezeNet)
-        {
-            mAPPs.push_back(new Application ((char*)"SqueezeNet"
-                , {1, 3, 112, 112}
-                , get<0>(task.second)                   // batch size
-                , get<1>(task.second) * GPU_F / 1000    // arrival time
-                , get<2>(task.second) * GPU_F / 1000    // period
-                // , get<3>(task.second) * GPU_F / 1000    //dead;ome
-                , GPU_F * SIMULATION_TIME / 1000
-            ));
-        }
-        else if(task.first == APPLICATION::LIGHT)
-        {
-            command.TASK_LIST.emplace_back(make_pair(APPLICATION::LeNet,     task.second));
-            command.TASK_LIST.emplace_back(make_pair(APPLICATION::ResNet18,  task.second));
-        }
-        else if (task.first == APPLICATION::HEAVY)
-        {
-            command.TASK_LIST.emplace_back(make_pair(APPLICATION::GoogleNet, task.second));
-            command.TASK_LIST.emplace_back(make_pair(APPLICATION::VGG16,     task.second));
-        }
-        else if (task.first == APPLICATION::MIX)
-        {
-            command.TASK_LIST.emplace_back(make_pair(APPLICATION::LeNet,     task.second));
-            command.TASK_LIST.emplace_back(make_pair(APPLICATION::ResNet18,  task.second));
-            command.TASK_LIST.emplace_back(make_pair(APPLICATION::GoogleNet, task.second));
-            command.TASK_LIST.emplace_back(make_pair(APPLICATION::VGG16,     task.second));
-        }
-        else if (task.first == APPLICATION::ALL)
-        {
-            command.TASK_LIST.emplace_back(make_pair(APPLICATION::LeNet,     task.second));
-            command.TASK_LIST.emplace_back(make_pair(APPLICATION::CaffeNet,  task.second));
-            command.TASK_LIST.emplace_back(make_pair(APPLICATION::ResNet18,  task.second));
-            command.TASK_LIST.emplace_back(make_pair(APPLICATION::GoogleNet, task.second));
-            command.TASK_LIST.emplace_back(make_pair(APPLICATION::VGG16,     task.second));
-        }
-        else {
-            ASSERT(false, "Test set error");
-        }
-    }
-
     /* *******************************************************************
      * Set deadline
      * *******************************************************************
@@ -237,8 +136,10 @@ CPU::Check_Finish_Kernel()
             mGPU->getGMMU()->freeCGroup((*model)->appID);
 
             /* Record the kernel information into file */
-            ofstream file(LOG_OUT_PATH + program_name + ".txt", std::ios::app);
-                file << "PageRecord: [" << page_record.read_counter << ", " << page_record.write_counter << ", " << page_record.access_count << ", " << page_record.swap_count << "]" << std::endl;
+            LogStream file;
+                file << "PageRecord: [" << page_record.read_counter << ", " << page_record.write_counter << ", " << page_record.access_count << ", " << page_record.swap_count << ", " << page_record.writeback_count;
+                if (command.ACCESS_COUNTER_THRESHOLD) file << ", " << page_record.remote_count;
+                file << "]" << std::endl;
                 file << "App " << (*model)->appID << " Model " << buff << std::endl;
             file.close();
 
@@ -269,3 +170,51 @@ CPU::Check_All_Applications_Finish()
     return finish;
 }
 
+
+/** ===============================================================================================
+ * \name    getApplication
+ * 
+ * \brief   Find the application placed on this GPU
+ * 
+ * \param   app_id    the index of application
+ * 
+ * \return  the application, nullptr if it is placed on another GPU
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+Application*
+CPU::getApplication(int app_id)
+{
+    for (auto app : mAPPs) if (app->appID == app_id) return app;
+
+    return nullptr;
+}
+
+
+/** ===============================================================================================
+ * \name    nextEventCycle
+ * 
+ * \brief   The cycle of the next CPU event, the scheduler only runs on the finished kernel or the
+ *          idle GPU, otherwise the CPU waits for the next arrival
+ * 
+ * \return  the current cycle if the CPU has work to do, -1 if no event
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+unsigned long long
+CPU::nextEventCycle()
+{
+    unsigned long long next_cycle = -1;
+    for (auto app : mAPPs)
+    {
+        bool has_model = !app->waitingModels.empty() || !app->runningModels.empty();
+        if (mGPU->isIdle() && has_model) return total_gpu_cycle;
+
+        if (app->arrivalTime < app->endTime)  next_cycle = min(next_cycle, app->arrivalTime);
+        else if (!has_model && !app->finish) return total_gpu_cycle;
+    }
+
+    return next_cycle;
+}
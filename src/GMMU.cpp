@@ -8,6 +8,26 @@
 
 #include "include/GPU.hpp"
 #include "include/GMMU.hpp"
+#include "include/Trace.hpp"
+#include "include/Timeline.hpp"
+#include "include/Statistics.hpp"
+
+/* ************************************************************************************************
+ * Global Variable
+ * ************************************************************************************************
+ */
+/* Statistic */
+static const Statistics::Counter   stat_access              = Statistics::instance().counter("gmmu.access");
+static const Statistics::Histogram stat_access_latency      = Statistics::instance().histogram("gmmu.access_latency", "cycle");
+static const Statistics::Counter   stat_fault_page          = Statistics::instance().counter("gmmu.fault_page", "page");
+static const Statistics::Histogram stat_fault_batch_page    = Statistics::instance().histogram("gmmu.fault_batch_page", "page");
+static const Statistics::Histogram stat_fault_batch_latency = Statistics::instance().histogram("gmmu.fault_batch_latency", "cycle");
+static const Statistics::Counter   stat_migrate_page        = Statistics::instance().counter("gmmu.migrate_page", "page");
+static const Statistics::Counter   stat_writeback_page      = Statistics::instance().counter("gmmu.writeback_page", "page");
+static const Statistics::Counter   stat_prefetch_page       = Statistics::instance().counter("gmmu.prefetch_page", "page");
+static const Statistics::Counter   stat_remote_access       = Statistics::instance().counter("gmmu.remote_access");
+static const Statistics::Counter   stat_peer_evict_page     = Statistics::instance().counter("gmmu.peer_evict_page", "page");
+static const Statistics::Counter   stat_peer_fetch_page     = Statistics::instance().counter("gmmu.peer_fetch_page", "page");
 
 /** ===============================================================================================
  * \name    GMMU
@@ -17,7 +37,7 @@
  * \endcond
  * ================================================================================================
  */
-GMMU::GMMU(GPU* gpu, MemoryController* mc) : mGPU(gpu), mMC(mc)
+GMMU::GMMU(GPU* gpu, MemoryController* mc, int gpu_id) : gpuID(gpu_id), mGPU(gpu), mMC(mc), mChannel(mc->getChannel(gpu_id))
 {
     
 }
@@ -49,6 +69,8 @@ void
 GMMU::cycle()
 {
     log_I("GMMU Cycle", to_string(total_gpu_cycle));
+
+    gmmu_cycle++;
     
     Page_Fault_Handler();
 
@@ -75,11 +97,28 @@ GMMU::Access_Processing()
      * *******************************************************************
      */
 #if (LOG_LEVEL >= TRACE)
-    log_T("MC", "Retrun " + to_string(mMC->mc_to_gmmu_queue.size()) + " access");
+    log_T("MC", "Retrun " + to_string(mChannel->mc_to_gmmu_queue.size()) + " access");
 #endif
-    if(!mMC->mc_to_gmmu_queue.empty()) 
+    if(!mChannel->mc_to_gmmu_queue.empty()) 
+    {
+        gmmu_to_warps_queue.splice(gmmu_to_warps_queue.end(), mChannel->mc_to_gmmu_queue);
+    }
+
+    /* *******************************************************************
+     * Receive the finished remote accesses, which are in order of finish
+     * cycle due to the serialized PCIe link
+     * *******************************************************************
+     */
+    while (!remote_access_queue.empty() && remote_access_queue.front().first <= gmmu_cycle)
     {
-        gmmu_to_warps_queue.splice(gmmu_to_warps_queue.end(), mMC->mc_to_gmmu_queue);
+        auto access = remote_access_queue.front().second;
+        for (auto page_id : access->pageIDs)
+        {
+            Page* page = mMC->refer(page_id);
+            (access->type == Read) ? page->record.read_counter++ : page->record.write_counter++;
+        }
+        gmmu_to_warps_queue.push_back(access);
+        remote_access_queue.pop_front();
     }
     
 
@@ -93,8 +132,13 @@ GMMU::Access_Processing()
     while(!gmmu_to_warps_queue.empty())
     {
         auto access = gmmu_to_warps_queue.front();
-        mGPU->mSMs[access->sm_id].mWarps[access->warp_id].gmmu_to_warp_queue.push_back(access);
         gmmu_to_warps_queue.pop_front();
+
+        if (trace_recorder) trace_recorder->returnAccess(access);
+        stat_access_latency.record(total_gpu_cycle - access->issue_cycle);
+
+        if (mReplayer) mReplayer->returnAccess(access);
+        else mGPU->mSMs[access->sm_id].mWarps[access->warp_id].gmmu_to_warp_queue.push_back(access);
     }
 
 
@@ -113,6 +157,9 @@ GMMU::Access_Processing()
                 {
                     warps_to_gmmu_queue.push_back(mGPU->mSMs[i].mWarps[j].warp_to_gmmu_queue.front());
                     mGPU->mSMs[i].mWarps[j].warp_to_gmmu_queue.pop_front();
+                    if (trace_recorder) trace_recorder->issueAccess(warps_to_gmmu_queue.back());
+                    warps_to_gmmu_queue.back()->issue_cycle = total_gpu_cycle;
+                    stat_access.add();
                     empty = false;
                 }
             }
@@ -139,7 +186,8 @@ GMMU::Access_Processing()
         for (auto page_id : access->pageIDs) hit &= TLB->lookup(page_id, dummy_page);
 
         /* Classify the access into correspond handling queue */
-        hit ? mMC->gmmu_to_mc_queue.push_back(access) : MSHRs.push_back(access);
+        if (hit)                        mChannel->gmmu_to_mc_queue.push_back(access);
+        else if (!Remote_Access(access)) Fault_Merging(access);
 
         warps_to_gmmu_queue.pop_front();
     }
@@ -160,6 +208,8 @@ GMMU::Page_Fault_Handler()
 #if (LOG_LEVEL >= TRACE)
     log_T("GMMU", "Page_Fault_Handler");
 #endif
+    if (wait_cycle > 0 || !page_fault_process_queue.empty() || !pending_pages.empty()) fault_handler_cycle++;
+
     /* *******************************************************************
      * Waiting for communication to the CPU and migration overhead
      * *******************************************************************
@@ -179,86 +229,98 @@ GMMU::Page_Fault_Handler()
      */
     else if (!page_fault_process_queue.empty())
     {
-        auto access_pair = page_fault_process_queue.front();
-
-        /* Migration from DRAM to VRAM */
-        unsigned long long page_id = access_pair.first;
-        Page* page = mMC->refer(page_id);
-        page->location = SPACE_VRAM;
-        page->record.swap_count++;
+        unsigned long long page_id = page_fault_process_queue.front();
+        page_fault_process_queue.pop_front();
 
-        for (auto access : access_pair.second)
+        /* The entry is removed if all the waiters are terminated */
+        auto it = mMSHR.find(page_id);
+        if (it != mMSHR.end())
         {
-            Page* evict_page = getCGroup(access->app_id)->insert(page_id, page);
+            /* Migration from DRAM, or from the VRAM of the peer, to VRAM */
+            Page* page = mMC->refer(page_id);
+            if (takePeerPage(page_id)) stat_peer_fetch_page.add();
+            page->location = SPACE_VRAM;
+            page->record.swap_count++;
+            page->record.access_counter = 0;
+
+            stat_migrate_page.add();
+            if (timeline) timeline->recordTransfer("Migrate", it->second.app_id, page_id, total_gpu_cycle - PAGE_FAULT_MIGRATION_UNIT_CYCLE * GPU_F / GMMU_F);
 
             /* Eviction happen */
-            if (evict_page)
+            Eviction eviction = insertPage(it->second.app_id, page);
+            if (eviction == EVICT_WRITEBACK)
             {
-                evict_page->location = SPACE_DRAM;
-                evict_page->record.swap_count++;
 #if (ENABLE_PAGE_FAULT_PENALTY)
                 wait_cycle = PAGE_FAULT_MIGRATION_UNIT_CYCLE;
 #endif
+                stat_writeback_page.add();
+                if (timeline) timeline->recordTransfer("Write back", it->second.app_id, page_id, total_gpu_cycle);
             }
-
-            if (--access_count[access] == 0)
+            else if (eviction == EVICT_PEER)
             {
-                warps_to_gmmu_queue.push_back(access);
-                access_count.erase(access_count.find(access));
+#if (ENABLE_PAGE_FAULT_PENALTY)
+                wait_cycle = PEER_MIGRATION_UNIT_CYCLE;
+#endif
+                stat_peer_evict_page.add();
             }
+
+            for (auto access : it->second.waiters) if (--access->outstanding == 0) warps_to_gmmu_queue.push_back(access);
+
+            mMSHR.erase(it);
         }
 
-        page_fault_process_queue.pop_front();
+        if (page_fault_process_queue.empty())
+        {
+            stat_fault_batch_latency.record(total_gpu_cycle - fault_batch_cycle);
+            if (timeline) timeline->recordFaultBatch(fault_batch_cycle, fault_batch_pages);
+        }
 
 #if (ENABLE_PAGE_FAULT_PENALTY)
-        if (!page_fault_process_queue.empty()) wait_cycle += PAGE_FAULT_MIGRATION_UNIT_CYCLE;
+        if (!page_fault_process_queue.empty()) wait_cycle += migrationCycle();
 #else            
         wait_cycle = 1;
 #endif
     }
     
     /* *******************************************************************
-     * Launch the access inside the MSHRs to handling queue, not remove the
-     * access from the MSHRs until processing over.
+     * Issue the pending pages of MSHR in the order of fault, the waiters
+     * stay in the entry until the page is migrated.
      * *******************************************************************
      */
-    else if (!MSHRs.empty())
+    else if (!pending_pages.empty())
     {
-        map<int, unordered_set<unsigned long long>> access_record;
-        unordered_map<unsigned long long, list<MemoryAccess*>> page_fault_record;
-        /* *******************************************************************
-         * Find the demanded pages
-         * *******************************************************************
-         */
-        list<MemoryAccess*> remaining_MSHRs = {};
-        for (auto access : MSHRs)
-        {
-            int app_id = MEMORY_ISOLATION ? access->app_id : -1;
+        /* Unpin the pages of previous batch */
+        for (auto page : pinned_pages) page->pinned = false;
+        pinned_pages.clear();
 
-            list<unsigned long long> page_list = {};
-            for (auto page_id : access->pageIDs) if (!getCGroup(app_id)->lookup(page_id)) page_list.push_back(page_id);
-            if (page_list.empty())
+        map<int, unsigned long long> cgroup_capacity;
+        for (auto it = pending_pages.begin(); it != pending_pages.end() && page_fault_process_queue.size() < MSHR_STACK_SIZE;)
+        {
+            auto entry = mMSHR.find(*it);
+            if (entry == mMSHR.end())
             {
-                warps_to_gmmu_queue.push_back(access);
+                pending_pages.erase(it++);
                 continue;
             }
 
-            int new_page = 0;
-            for (auto page_id : page_list) if (!access_record[app_id].count(page_id)) new_page++;
-            if (access_record[app_id].size() + new_page > getCGroup(app_id)->size() || page_fault_record.size() + new_page > MSHR_STACK_SIZE)
+            /* The pages of a cgroup in one batch cannot exceed its capacity */
+            int app_id = MEMORY_ISOLATION ? entry->second.app_id : -1;
+            if (!cgroup_capacity.count(app_id)) cgroup_capacity[app_id] = getCGroupCapacity(app_id);
+            if (cgroup_capacity[app_id] == 0)
             {
-                remaining_MSHRs.push_back(access);
+                it++;
                 continue;
             }
+            cgroup_capacity[app_id]--;
 
-            /* add the page access into queue */
-            access_record[app_id].insert(page_list.begin(), page_list.end());
-            for (auto page_id : page_list) page_fault_record[page_id].push_back(access);
-            access_count[access] += page_list.size();
-        }
+            /* pin the page, avoid being chosen as clean victim before the waiters are served */
+            Page* page = mMC->refer(*it);
+            page->pinned = true;
+            pinned_pages.push_back(page);
 
-        MSHRs = remaining_MSHRs;
-        page_fault_process_queue = list<pair<unsigned long long, list<MemoryAccess*>>>(page_fault_record.begin(), page_fault_record.end());
+            page_fault_process_queue.push_back(*it);
+            pending_pages.erase(it++);
+        }
         
 #if (PAGE_PREFETCH)
         /* *******************************************************************
@@ -299,19 +361,508 @@ GMMU::Page_Fault_Handler()
 #endif
 
 #if (ENABLE_PAGE_FAULT_PENALTY)
-        wait_cycle = PAGE_FAULT_COMMUNICATION_CYCLE + PAGE_FAULT_MIGRATION_UNIT_CYCLE;
+        wait_cycle = PAGE_FAULT_COMMUNICATION_CYCLE + migrationCycle();
 #else            
         wait_cycle = 1;
 #endif
 
+        fault_batch_cycle = total_gpu_cycle;
+        fault_batch_pages = page_fault_process_queue.size();
+        if (fault_batch_pages) stat_fault_batch_page.record(fault_batch_pages);
+
         log ("Demanded page number", to_string(page_fault_process_queue.size()), Color::Cyan);
 #if (PRINT_DEMAND_PAGE_RECORD)
-        ofstream file (LOG_OUT_PATH + program_name + ".txt", std::ios::app);
+        LogStream file;
             file << "Demanded page number: " << page_fault_process_queue.size() << std::endl;
         file.close();
 #endif
             
     }
+
+    /* *******************************************************************
+     * Migrate the prefetched page when no page fault is demanded, the
+     * demanded pages preempt the prefetch in page granularity
+     * *******************************************************************
+     */
+    else if (!prefetch_process_queue.empty())
+    {
+        unsigned long long page_id = prefetch_process_queue.front();
+        prefetch_process_queue.pop_front();
+
+        /* The entry is taken over by page fault if demanded before prefetched */
+        auto it = mMSHR.find(page_id);
+        if (it != mMSHR.end() && it->second.prefetch)
+        {
+            Page* page = mMC->refer(page_id);
+            if (takePeerPage(page_id)) stat_peer_fetch_page.add();
+            page->location = SPACE_VRAM;
+            page->record.swap_count++;
+            page->record.access_counter = 0;
+
+            insertPage(it->second.app_id, page);
+            stat_prefetch_page.add();
+            if (timeline) timeline->recordTransfer("Prefetch", it->second.app_id, page_id, total_gpu_cycle);
+
+            mMSHR.erase(it);
+        }
+
+#if (ENABLE_PAGE_FAULT_PENALTY)
+        wait_cycle = PAGE_FAULT_MIGRATION_UNIT_CYCLE;
+#else            
+        wait_cycle = 1;
+#endif
+    }
+
+    /* *******************************************************************
+     * Launch the prefetch requests by priority, the prefetch is initiated
+     * by driver, therefore no communication overhead. Each CGroup only
+     * prefetch up to half of its capacity in a batch, to keep the working
+     * set of running kernel.
+     * *******************************************************************
+     */
+    else if (!prefetch_queue.empty())
+    {
+        map<int, unsigned long long> prefetch_budget;
+        while (!prefetch_queue.empty() && prefetch_process_queue.size() < PCIE_ACCESS_BOUND)
+        {
+            auto& page_list = prefetch_queue.begin()->second;
+            auto prefetch_pair = page_list.front();
+            page_list.pop_front();
+            if (page_list.empty()) prefetch_queue.erase(prefetch_queue.begin());
+
+            int app_id = MEMORY_ISOLATION ? prefetch_pair.first : -1;
+            if (!prefetch_budget.count(app_id)) prefetch_budget[app_id] = getCGroupCapacity(app_id) / 2;
+
+            if (prefetch_budget[app_id] == 0 || mMSHR.count(prefetch_pair.second) || getCGroup(app_id)->lookup(prefetch_pair.second)) continue;
+
+            /* The prefetch entry has no waiter */
+            prefetch_budget[app_id]--;
+            mMSHR[prefetch_pair.second] = {prefetch_pair.first, true, {}};
+            prefetch_process_queue.push_back(prefetch_pair.second);
+        }
+
+        log_V("Prefetch page number", to_string(prefetch_process_queue.size()));
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    Fault_Merging
+ * 
+ * \brief   Register the access as the waiter of its non-resident pages. The fault on the page
+ *          already pending in the MSHR is merged into the entry.
+ * 
+ * \param   access    the access missing in the CGroup
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+GMMU::Fault_Merging (MemoryAccess* access)
+{
+    auto TLB = getCGroup(access->app_id);
+
+    for (auto page_id : access->pageIDs)
+    {
+        if (TLB->lookup(page_id)) continue;
+
+        auto it = mMSHR.find(page_id);
+        if (it == mMSHR.end())
+        {
+            it = mMSHR.emplace(page_id, MSHR_Entry{access->app_id, false, {}}).first;
+            pending_pages.push_back(page_id);
+            stat_fault_page.add();
+        }
+        /* The demanded page preempts the prefetch */
+        else if (it->second.prefetch)
+        {
+            it->second.prefetch = false;
+            pending_pages.push_back(page_id);
+            stat_fault_page.add();
+        }
+
+        /* The duplicated page in one access is merged */
+        auto& waiters = it->second.waiters;
+        if (waiters.empty() || waiters.back() != access)
+        {
+            waiters.push_back(access);
+            access->outstanding++;
+        }
+    }
+
+    if (access->outstanding == 0) warps_to_gmmu_queue.push_back(access);
+}
+
+
+/** ===============================================================================================
+ * \name    evictPage
+ * 
+ * \brief   Move the evicted page into the peer with the most idle pages, otherwise back to DRAM
+ * 
+ * \param   page      the page evicted from CGroup
+ * \param   to_peer   false for the page evicted from the peer CGroup, it goes back to DRAM
+ * 
+ * \return  EVICT_WRITEBACK if the page needs to write back, the clean page is dropped without
+ *          transfer, EVICT_PEER if the peer keeps the page
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+Eviction
+GMMU::evictPage (Page* page, bool to_peer)
+{
+    page->record.swap_count++;
+    page->record.access_counter = 0;
+
+    GMMU* peer = nullptr;
+    unsigned long long peer_idle_pages = 0;
+    for (auto gmmu : mPeers)
+    {
+        unsigned long long idle_pages = to_peer ? gmmu->getIdlePages() : 0;
+        if (idle_pages > peer_idle_pages)
+        {
+            peer = gmmu;
+            peer_idle_pages = idle_pages;
+        }
+    }
+    if (peer && peer->acceptPeerPage(page))
+    {
+        peer_evict_count++;
+        return EVICT_PEER;
+    }
+
+    page->location = SPACE_DRAM;
+
+    if (ENABLE_DIRTY_TRACKING && !page->dirty) return EVICT_NONE;
+
+    page->dirty = false;
+    page->record.writeback_count++;
+
+    return EVICT_WRITEBACK;
+}
+
+
+/** ===============================================================================================
+ * \name    insertPage
+ * 
+ * \brief   Insert the migrated page into the CGroup. The CGroup under its target reclaims the page
+ *          from the CGroup most exceeding its target, the CGroup reaching its target borrows the
+ *          idle page until the limit, otherwise evicts its own page. The pages kept for the peers
+ *          are evicted first once no idle page is left.
+ * 
+ * \param   app_id    the index of application
+ * \param   page      the page migrated into VRAM
+ * 
+ * \return  the transfer of the evicted page
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+Eviction
+GMMU::insertPage (int app_id, Page* page)
+{
+    int key = MEMORY_ISOLATION ? app_id : -1;
+    auto CGroup  = &mCGroups[key];
+    auto& record = mCGroupRecords[key];
+
+    if (CGroup->lookup(page->pageIndex))
+    {
+        CGroup->insert(page->pageIndex, page);
+        return EVICT_NONE;
+    }
+
+    auto peer_cgroup = mCGroups.find(PEER_CGROUP);
+    bool peer_page = peer_cgroup != mCGroups.end() && peer_cgroup->second.usage() > 0;
+
+    unsigned long long usage = 0;
+    for (auto& cgroup_pair : mCGroups) usage += cgroup_pair.second.usage();
+    bool idle_page = usage < system_resource.VRAM_SPACE / PAGE_SIZE;
+
+    Page* evict_page = nullptr;
+    bool to_peer = true;
+    if (CGroup->usage() < record.limit && idle_page)
+    {
+        if (CGroup->usage() >= record.target) record.borrow_count++;
+    }
+    else if (CGroup->usage() < record.limit && peer_page)
+    {
+        /* The page kept for the peer goes back to DRAM */
+        if (CGroup->usage() >= record.target) record.borrow_count++;
+        mCGroupRecords[PEER_CGROUP].reclaim_count++;
+        evict_page = peer_cgroup->second.evict();
+        to_peer = false;
+    }
+    else if (CGroup->usage() < record.target)
+    {
+        /* Reclaim from the cgroup most exceeding its target */
+        int victim_key = key;
+        unsigned long long max_excess = 0;
+        for (auto& cgroup_pair : mCGroups)
+        {
+            unsigned long long target = mCGroupRecords[cgroup_pair.first].target;
+            if (cgroup_pair.second.usage() > target && cgroup_pair.second.usage() - target > max_excess)
+            {
+                max_excess = cgroup_pair.second.usage() - target;
+                victim_key = cgroup_pair.first;
+            }
+        }
+        victim_key == key ? record.evict_count++ : mCGroupRecords[victim_key].reclaim_count++;
+        evict_page = mCGroups[victim_key].evict();
+    }
+    else
+    {
+        record.evict_count++;
+        evict_page = CGroup->evict();
+    }
+
+    /* The TLB grows lazily, the limit is managed by GMMU */
+    if (CGroup->usage() >= CGroup->size()) CGroup->resize(CGroup->usage() + 1);
+    CGroup->insert(page->pageIndex, page);
+
+    return evict_page ? evictPage(evict_page, to_peer) : EVICT_NONE;
+}
+
+
+/** ===============================================================================================
+ * \name    acceptPeerPage
+ * 
+ * \brief   Keep the page evicted by the peer in the idle page, the page is released to the peer
+ *          once it is faulted again, or evicted to DRAM once this GPU needs the page
+ * 
+ * \param   page      the page evicted by the peer
+ * 
+ * \return  true if the page is kept
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+bool
+GMMU::acceptPeerPage (Page* page)
+{
+    if (getIdlePages() == 0) return false;
+
+    auto& cgroup = mCGroups[PEER_CGROUP];
+    if (cgroup.usage() >= cgroup.size()) cgroup.resize(cgroup.usage() + 1);
+    cgroup.insert(page->pageIndex, page);
+
+    return true;
+}
+
+
+/** ===============================================================================================
+ * \name    takePeerPage
+ * 
+ * \brief   Release the page kept for this GPU by the peer
+ * 
+ * \param   page_id   the page migrated into this GPU
+ * 
+ * \return  true if the page is migrated from the peer over the peer link
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+bool
+GMMU::takePeerPage (unsigned long long page_id)
+{
+    for (auto peer : mPeers)
+    {
+        auto it = peer->mCGroups.find(PEER_CGROUP);
+        if (it != peer->mCGroups.end() && it->second.erase(page_id))
+        {
+            peer_fetch_count++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/** ===============================================================================================
+ * \name    releasePeerPages
+ * 
+ * \brief   Drop the pages released by the applications of the peer
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+inline bool isReleased (Page* const& page) { return page->location == SPACE_DRAM; }
+/*
+ * ================================================================================================
+ */
+void
+GMMU::releasePeerPages ()
+{
+    auto it = mCGroups.find(PEER_CGROUP);
+    if (it != mCGroups.end()) it->second.release( isReleased );
+}
+
+
+/** ===============================================================================================
+ * \name    migrationCycle
+ * 
+ * \brief   The transfer cycle of the next page in the page fault batch, over the peer link if the
+ *          page is kept by a peer, otherwise over PCIe
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+double
+GMMU::migrationCycle ()
+{
+    if (page_fault_process_queue.empty()) return PAGE_FAULT_MIGRATION_UNIT_CYCLE;
+
+    unsigned long long page_id = page_fault_process_queue.front();
+    for (auto peer : mPeers)
+    {
+        auto it = peer->mCGroups.find(PEER_CGROUP);
+        if (it != peer->mCGroups.end() && it->second.lookup(page_id)) return PEER_MIGRATION_UNIT_CYCLE;
+    }
+
+    return PAGE_FAULT_MIGRATION_UNIT_CYCLE;
+}
+
+
+/** ===============================================================================================
+ * \name    getIdlePages
+ * 
+ * \brief   Get the number of VRAM pages not used by any CGroup
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+unsigned long long
+GMMU::getIdlePages ()
+{
+    unsigned long long usage = 0;
+    for (auto& cgroup_pair : mCGroups) usage += cgroup_pair.second.usage();
+
+    return system_resource.VRAM_SPACE / PAGE_SIZE - min(usage, (unsigned long long)(system_resource.VRAM_SPACE / PAGE_SIZE));
+}
+
+
+/** ===============================================================================================
+ * \name    prefetch
+ * 
+ * \brief   Queue the pages to migrate into the CGroup in background, like cudaMemPrefetchAsync.
+ *          The prefetch is served when the page fault handler is idle.
+ * 
+ * \param   app_id      the index of application
+ * \param   page_list   the physical pages to prefetch, translated by MMU::addressTranslate
+ * \param   priority    the higher priority is prefetched first
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+GMMU::prefetch (int app_id, const vector<unsigned long long>& page_list, int priority)
+{
+    if (trace_recorder) trace_recorder->recordEvent(TRACE_PREFETCH, {app_id, priority}, page_list);
+
+    auto& queue = prefetch_queue[priority];
+    for (auto page_id : page_list) queue.emplace_back(make_pair(app_id, page_id));
+
+    if (queue.empty()) prefetch_queue.erase(priority);
+}
+
+
+/** ===============================================================================================
+ * \name    migratePages
+ * 
+ * \brief   Migrate the non-resident pages into the CGroup at once without the page fault handler,
+ *          used by the analytic fidelity to keep the CGroups as the cycle mode does
+ * 
+ * \param   app_id      the index of application
+ * \param   page_list   the physical pages accessed by the kernel
+ * 
+ * \return  first: number of migrated pages, second: number of written back pages
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+pair<unsigned long long, unsigned long long>
+GMMU::migratePages (int app_id, const vector<unsigned long long>& page_list)
+{
+    auto TLB = getCGroup(app_id);
+
+    pair<unsigned long long, unsigned long long> count = {0, 0};
+    for (auto page_id : page_list)
+    {
+        Page* page = mMC->refer(page_id);
+        if (!TLB->lookup(page_id))
+        {
+            if (takePeerPage(page_id)) stat_peer_fetch_page.add();
+            page->location = SPACE_VRAM;
+            page->record.swap_count++;
+            page->record.access_counter = 0;
+            count.first++;
+        }
+        count.second += (insertPage(app_id, page) != EVICT_NONE);
+    }
+
+    return count;
+}
+
+
+/** ===============================================================================================
+ * \name    isIdle
+ * 
+ * \brief   Check whether no access, page fault, prefetch and memory request is in flight
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+bool
+GMMU::isIdle ()
+{
+    return warps_to_gmmu_queue.empty() && gmmu_to_warps_queue.empty() && remote_access_queue.empty()
+        && mMSHR.empty() && pending_pages.empty() && page_fault_process_queue.empty() && wait_cycle <= 0
+        && prefetch_queue.empty() && prefetch_process_queue.empty()
+        && mChannel->gmmu_to_mc_queue.empty() && mChannel->mc_to_gmmu_queue.empty();
+}
+
+
+/** ===============================================================================================
+ * \name    Remote_Access
+ * 
+ * \brief   Serve the non-resident pages of the access directly over PCIe (zero-copy) until one of
+ *          the pages crosses the access counter threshold, which migrates it by page fault.
+ * 
+ * \param   access    the access missing in the CGroup
+ * 
+ * \return  true if the access is served remotely, false if it needs the page fault handler
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+bool
+GMMU::Remote_Access (MemoryAccess* access)
+{
+    if (command.ACCESS_COUNTER_THRESHOLD == 0) return false;
+
+    auto TLB = getCGroup(access->app_id);
+
+    list<Page*> remote_pages = {};
+    bool migrate = false;
+    for (auto page_id : access->pageIDs)
+    {
+        if (TLB->lookup(page_id)) continue;
+
+        Page* page = mMC->refer(page_id);
+        if (++page->record.access_counter >= command.ACCESS_COUNTER_THRESHOLD) migrate = true;
+        remote_pages.push_back(page);
+    }
+    if (migrate || remote_pages.empty()) return false;
+
+    for (auto page : remote_pages) page->record.remote_count++;
+    stat_remote_access.add();
+
+    /* The PCIe link is serialized, each non-resident page transfers one cache line */
+    unsigned long long start_cycle = max(gmmu_cycle, pcie_free_cycle);
+    pcie_free_cycle = start_cycle + remote_pages.size() * REMOTE_ACCESS_UNIT_CYCLE;
+    remote_access_queue.emplace_back(make_pair(pcie_free_cycle + REMOTE_ACCESS_CYCLE, access));
+
+    return true;
 }
 
 
@@ -332,18 +883,26 @@ GMMU::Page_Fault_Handler()
 bool
 GMMU::terminateModel(int app_id, int model_id)
 {
+    if (trace_recorder) trace_recorder->recordEvent(TRACE_TERMINATE, {app_id, model_id});
+
     warps_to_gmmu_queue.remove_if([model_id](MemoryAccess* access){return access->model_id == model_id;});
     gmmu_to_warps_queue.remove_if([model_id](MemoryAccess* access){return access->model_id == model_id;});
 
-    for (auto page_pair : page_fault_process_queue)
+    remote_access_queue.remove_if([model_id](auto& pair){return pair.second->model_id == model_id;});
+
+    /* The issued and pending page without waiter is dropped */
+    for (auto it = mMSHR.begin(); it != mMSHR.end();)
     {
-        page_pair.second.remove_if([model_id](MemoryAccess* access){return access->model_id == model_id;});
+        auto& waiters = it->second.waiters;
+        waiters.remove_if([model_id](MemoryAccess* access){return access->model_id == model_id;});
+        (waiters.empty() && !it->second.prefetch) ? mMSHR.erase(it++) : it++;
     }
-    page_fault_process_queue.remove_if([](auto& pair){return pair.second.empty();});
+    page_fault_process_queue.remove_if([this](auto page_id){return !mMSHR.count(page_id);});
+    pending_pages.remove_if([this](auto page_id){return !mMSHR.count(page_id);});
     if (page_fault_process_queue.empty()) wait_cycle = 0;
 
-    mMC->mc_to_gmmu_queue.remove_if([model_id](MemoryAccess* access){return access->model_id == model_id;});
-    mMC->gmmu_to_mc_queue.remove_if([model_id](MemoryAccess* access){return access->model_id == model_id;});
+    mChannel->mc_to_gmmu_queue.remove_if([model_id](MemoryAccess* access){return access->model_id == model_id;});
+    mChannel->gmmu_to_mc_queue.remove_if([model_id](MemoryAccess* access){return access->model_id == model_id;});
 
     freeCGroup(app_id);
 
@@ -351,6 +910,45 @@ GMMU::terminateModel(int app_id, int model_id)
 }
 
 
+/** ===============================================================================================
+ * \name    issueAccess
+ * 
+ * \brief   Receive the access from the trace replayer instead of the SMs
+ * 
+ * \param   access    the replayed access
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+GMMU::issueAccess (MemoryAccess* access)
+{
+    access->issue_cycle = total_gpu_cycle;
+    stat_access.add();
+
+    warps_to_gmmu_queue.push_back(access);
+}
+
+
+/** ===============================================================================================
+ * \name    setCGroupType
+ * 
+ * \brief   Isolate the CGroup of each application, or share one CGroup
+ * 
+ * \param   isolation   true to isolate the applications
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+GMMU::setCGroupType (bool isolation)
+{
+    if (trace_recorder) trace_recorder->recordEvent(TRACE_CGROUP_TYPE, {isolation});
+
+    MEMORY_ISOLATION = isolation;
+}
+
+
 /** ===============================================================================================
  * \name    setCGroupSize
  * 
@@ -362,12 +960,23 @@ GMMU::terminateModel(int app_id, int model_id)
  * \endcond
  * ================================================================================================
  */
+inline bool isCleanVictim (Page* const& page) { return !page->dirty && !page->pinned; }
+/*
+ * ================================================================================================
+ */
 void
-GMMU::setCGroupSize (int app_id, unsigned long long capacity)
+GMMU::setCGroupSize (int app_id, unsigned long long capacity, unsigned long long limit)
 {
-    mCGroups[app_id].resize(capacity);
+    if (trace_recorder) trace_recorder->recordEvent(TRACE_CGROUP_SIZE, {app_id, (long long)capacity, (long long)limit});
 
-    log("setCGroupSize", "[" + to_string(app_id) + ", " + to_string(mCGroups[app_id].size()) + "]", Color::Cyan);
+#if (ENABLE_DIRTY_TRACKING)
+    mCGroups[app_id].setVictimPreference( isCleanVictim, CLEAN_VICTIM_SCAN_WINDOW );
+#endif
+    /* Shrinking only lower the target, the pages are reclaimed lazily */
+    mCGroupRecords[app_id].target = capacity;
+    mCGroupRecords[app_id].limit  = max(capacity, min(limit, (unsigned long long)(system_resource.VRAM_SPACE / PAGE_SIZE)));
+
+    log("setCGroupSize", "[" + to_string(app_id) + ", " + to_string(mCGroupRecords[app_id].target) + "]", Color::Cyan);
 }
 
 
@@ -388,12 +997,29 @@ inline bool check (Page* const& page) { return page->location == SPACE_DRAM; }
 void
 GMMU::freeCGroup (int app_id)
 {
+    if (trace_recorder) trace_recorder->recordEvent(TRACE_CGROUP_FREE, {app_id});
+
+    /* Drop the prefetch requests of the application */
+    for (auto it = prefetch_queue.begin(); it != prefetch_queue.end();)
+    {
+        it->second.remove_if([app_id](auto& pair){return pair.first == app_id;});
+        it->second.empty() ? prefetch_queue.erase(it++) : it++;
+    }
+    for (auto it = mMSHR.begin(); it != mMSHR.end();)
+    {
+        (it->second.prefetch && it->second.app_id == app_id) ? mMSHR.erase(it++) : it++;
+    }
+    prefetch_process_queue.remove_if([this](auto page_id){return !mMSHR.count(page_id);});
+
     auto it = mCGroups.find(MEMORY_ISOLATION ? app_id : -1);
     if (it != mCGroups.end()) 
     {
         int release_count = (*it).second.release( check );
         log_V("freeCGroup", "release " + to_string(release_count) + " pages from the CGroup " + to_string((*it).first));
     }
+
+    /* The released pages kept by the peers */
+    for (auto peer : mPeers) peer->releasePeerPages();
 }
 
 
@@ -411,4 +1037,89 @@ LRU_TLB<unsigned long long, Page*>*
 GMMU::getCGroup (int app_id)
 {
     return &mCGroups[MEMORY_ISOLATION ? app_id : -1];
+}
+
+
+/** ===============================================================================================
+ * \name    getCGroupTarget
+ * 
+ * \brief   Get the target size of CGroup given by scheduler
+ * 
+ * \param   app_id    the index of application
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+unsigned long long
+GMMU::getCGroupTarget (int app_id)
+{
+    return mCGroupRecords[MEMORY_ISOLATION ? app_id : -1].target;
+}
+
+
+/** ===============================================================================================
+ * \name    getCGroupCapacity
+ * 
+ * \brief   Get the number of pages the CGroup can hold without evicting its own pages, including
+ *          the reclaimable pages under target and the borrowable idle pages
+ * 
+ * \param   app_id    the index of application
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+unsigned long long
+GMMU::getCGroupCapacity (int app_id)
+{
+    int key = MEMORY_ISOLATION ? app_id : -1;
+    auto& record = mCGroupRecords[key];
+
+    unsigned long long usage = 0;
+    for (auto& cgroup_pair : mCGroups) usage += cgroup_pair.second.usage();
+    unsigned long long idle_pages = system_resource.VRAM_SPACE / PAGE_SIZE - min(usage, (unsigned long long)(system_resource.VRAM_SPACE / PAGE_SIZE));
+
+    return min(record.limit, max(record.target, mCGroups[key].usage() + idle_pages));
+}
+
+
+/** ===============================================================================================
+ * \name    printCGroupRecord
+ * 
+ * \brief   Print the target, usage and the statistic of each CGroup
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+GMMU::printCGroupRecord ()
+{
+    stringstream buff;
+    buff << std::left << std::setw(10) << "CGroup"
+         << std::left << std::setw(10) << "Target"
+         << std::left << std::setw(10) << "Limit"
+         << std::left << std::setw(10) << "Usage"
+         << std::left << std::setw(10) << "Borrow"
+         << std::left << std::setw(10) << "Reclaim"
+         << std::left << std::setw(10) << "Evict"
+         << std::endl;
+
+    for (auto& cgroup_pair : mCGroups)
+    {
+        auto& record = mCGroupRecords[cgroup_pair.first];
+        buff << std::left << std::setw(10) << (cgroup_pair.first == PEER_CGROUP ? "Peer" : to_string(cgroup_pair.first))
+             << std::left << std::setw(10) << record.target
+             << std::left << std::setw(10) << record.limit
+             << std::left << std::setw(10) << cgroup_pair.second.usage()
+             << std::left << std::setw(10) << record.borrow_count
+             << std::left << std::setw(10) << record.reclaim_count
+             << std::left << std::setw(10) << record.evict_count
+             << std::endl;
+    }
+
+    std::cout << buff.str();
+#if (PRINT_CGROUP_RECORD)
+    LogStream file;
+        file << buff.str();
+    file.close();
+#endif
 }
\ No newline at end of file
@@ -11,11 +11,8 @@
  * Global Variable
  * ************************************************************************************************
  */
-/* Statistic */
-unsigned long long total_gpu_cycle = 0;
-
-/* Thread Protect */
-pthread_mutex_t* ioMutex = new pthread_mutex_t;
+/* Statistic, the host time of the simulation loop */
+static const Statistics::Counter stat_run_time = Statistics::instance().counter("host.run_time", "us");
 
 /** ===============================================================================================
  * \name    GPGPU
@@ -25,15 +22,40 @@ pthread_mutex_t* ioMutex = new pthread_mutex_t;
  * \endcond
  * ================================================================================================
  */
-GPGPU::GPGPU() : mMC(MemoryController(system_resource.DRAM_SPACE + system_resource.VRAM_SPACE, PAGE_SIZE)), mGPU(GPU(&mMC)), mCPU(CPU(&mMC, &mGPU))
+GPGPU::GPGPU() : mMC(MemoryController(system_resource.DRAM_SPACE + system_resource.VRAM_SPACE * command.GPU_NUM, PAGE_SIZE, command.GPU_NUM))
+               , mNode(NodeScheduler(command.GPU_NUM))
 {
-    mGMMU = mGPU.getGMMU();
-	pthread_mutex_init(ioMutex, NULL);
+	for (int i = 0; i < command.GPU_NUM; i++)
+	{
+		mGPUs.push_back(new GPU(&mMC, i));
+		mCPUs.push_back(new CPU(&mMC, mGPUs.back(), mNode.getApplications(i)));
+	}
+
+	/* The GPUs evict into and fetch from the VRAM of each other */
+	if (command.PEER_LINK)
+	{
+		for (auto gpu : mGPUs)
+		{
+			vector<GMMU*> peers;
+			for (auto peer : mGPUs) if (peer != gpu) peers.push_back(peer->getGMMU());
+			gpu->getGMMU()->setPeers(peers);
+		}
+	}
 
 	std::cout << program_name << std::endl;
 
-	ofstream file(LOG_OUT_PATH + program_name + ".txt", std::ofstream::out | std::ofstream::trunc);
-	file.close();
+	LogWriter::instance().open(LOG_OUT_PATH + program_name + ".txt");
+
+	if (command.GPU_NUM > 1) mNode.printPlacement();
+
+	if (!command.TRACE_RECORD_PATH.empty()) trace_recorder = new TraceRecorder(command.TRACE_RECORD_PATH);
+	if (!command.TIMELINE_PATH.empty())     timeline       = new TimelineWriter(command.TIMELINE_PATH);
+	if (!command.STATS_PATH.empty())        Statistics::instance().open(command.STATS_PATH, command.STATS_INTERVAL);
+	if (!command.TRACE_REPLAY_PATH.empty())
+	{
+		mReplayer = new TraceReplayer(command.TRACE_REPLAY_PATH, mGPUs.front()->getGMMU(), &mMC);
+		mGPUs.front()->getGMMU()->setTraceReplayer(mReplayer);
+	}
 }
 
 
@@ -47,7 +69,18 @@ GPGPU::GPGPU() : mMC(MemoryController(system_resource.DRAM_SPACE + system_resour
  */
 GPGPU::~GPGPU()
 {
+	delete trace_recorder;
+	trace_recorder = nullptr;
+
+	delete timeline;
+	timeline = nullptr;
+
+	delete mReplayer;
 
+	for (auto gpu : mGPUs) delete gpu;
+	for (auto cpu : mCPUs) delete cpu;
+
+	LogWriter::instance().close();
 }
 
 
@@ -62,7 +95,8 @@ GPGPU::~GPGPU()
 void 
 GPGPU::run ()
 {
-	timeval start, end;
+	timeval start, end, run_start;
+	gettimeofday(&run_start, NULL);
     bool Finish = false;
 	while (!Finish)
     {       
@@ -82,7 +116,8 @@ GPGPU::run ()
 #if (PRINT_TIME_STEP)
 			gettimeofday(&start, NULL);
 #endif
-			mGMMU->cycle();
+			if (mReplayer) mReplayer->cycle();
+			for (auto gpu : mGPUs) gpu->getGMMU()->cycle();
 #if (PRINT_TIME_STEP)
 			gettimeofday(&end, NULL);
 			std::cout << "GMMU cycle spend time: " << to_string((1000000 * (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec)) * 0.001) << " ms" << std::endl;
@@ -92,25 +127,45 @@ GPGPU::run ()
 #if (PRINT_TIME_STEP)
 			gettimeofday(&start, NULL);
 #endif
-			mGPU.cycle();
+			if (!mReplayer) for (auto gpu : mGPUs) gpu->cycle();
 #if (PRINT_TIME_STEP)
 			gettimeofday(&end, NULL);
 			std::cout << "GPU cycle spend time: " << to_string((1000000 * (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec)) * 0.001) << " ms" << std::endl;
 #endif
 			if (++total_gpu_cycle % 10000 == 0) std::cout << total_gpu_cycle << std::endl;
+			Statistics::instance().cycle();
 		}
 		if (clock_mask & CPU_MASK) {
 #if (PRINT_TIME_STEP)
 			gettimeofday(&start, NULL);
 #endif
-			mCPU.cycle();
+			if (!mReplayer) for (auto cpu : mCPUs) cpu->cycle();
 #if (PRINT_TIME_STEP)
 			gettimeofday(&end, NULL);
 			std::cout << "CPU cycle spend time: " << to_string((1000000 * (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec)) * 0.001) << " ms" << std::endl;
 #endif
 		}
-        Finish = mCPU.Check_All_Applications_Finish();
+        Finish = true;
+        if (mReplayer) Finish = mReplayer->isFinish();
+        else for (auto cpu : mCPUs) Finish &= cpu->Check_All_Applications_Finish();
+
+        if (!Finish && (command.FIDELITY_MODE != CYCLE || command.MEMO_MODE != NO_MEMO || mReplayer)) skip_idle_cycles();
     }
+
+	if (mReplayer) mReplayer->printInfo();
+
+	for (auto gpu : mGPUs)
+	{
+		if (mGPUs.size() > 1) log_W("GPU", to_string(gpu->gpuID));
+		gpu->getGMMU()->printCGroupRecord();
+		gpu->printAnalyticRecord();
+		gpu->printMemoRecord();
+	}
+	if (mGPUs.size() > 1) printNodeRecord();
+
+	gettimeofday(&end, NULL);
+	stat_run_time.add(1000000 * (end.tv_sec - run_start.tv_sec) + (end.tv_usec - run_start.tv_usec));
+	Statistics::instance().close();
 }
 
 
@@ -146,4 +201,64 @@ GPGPU::next_clock_domain()
 	}
 
 	return mask;
+}
+
+
+/** ===============================================================================================
+ * \name    skip_idle_cycles
+ * 
+ * \brief   Advance all clock domains to the next event, the modules have nothing to do while the
+ *          analytic and the fast-forwarded kernels are running
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+GPGPU::skip_idle_cycles()
+{
+	unsigned long long next_cycle = mReplayer ? mReplayer->nextEventCycle() : -1;
+	for (auto gpu : mGPUs) next_cycle = min(next_cycle, gpu->nextEventCycle());
+	if (!mReplayer) for (auto cpu : mCPUs) next_cycle = min(next_cycle, cpu->nextEventCycle());
+	if (next_cycle == (unsigned long long)-1 || next_cycle <= total_gpu_cycle) return;
+
+	long double skip_time = (next_cycle - total_gpu_cycle) / GPU_F;
+	total_gpu_cycle = next_cycle;
+
+	gpu_time  += skip_time;
+	cpu_time  += skip_time;
+	mc_time   += skip_time;
+	gmmu_time += skip_time;
+}
+
+
+/** ===============================================================================================
+ * \name    printNodeRecord
+ * 
+ * \brief   Print the pages each GPU evicted into and fetched from its peers
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+GPGPU::printNodeRecord()
+{
+	stringstream buff;
+	buff << std::left << std::setw(10) << "GPU"
+	     << std::left << std::setw(12) << "PeerEvict"
+	     << std::left << std::setw(12) << "PeerFetch"
+	     << std::endl;
+
+	for (auto gpu : mGPUs)
+	{
+		auto record = gpu->getGMMU()->getPeerRecord();
+		buff << std::left << std::setw(10) << gpu->gpuID
+		     << std::left << std::setw(12) << record.first
+		     << std::left << std::setw(12) << record.second
+		     << std::endl;
+	}
+
+	std::cout << buff.str();
+	LogStream file;
+		file << buff.str();
+	file.close();
 }
\ No newline at end of file
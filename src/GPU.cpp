@@ -8,6 +8,24 @@
 
 #include "include/GPU.hpp"
 #include "include/GMMU.hpp"
+#include "include/Trace.hpp"
+#include "include/Statistics.hpp"
+
+/* ************************************************************************************************
+ * Global Variable
+ * ************************************************************************************************
+ */
+/* Statistic */
+static const Statistics::Counter   stat_kernel_finish  = Statistics::instance().counter("kernel.finish");
+static const Statistics::Histogram stat_kernel_latency = Statistics::instance().histogram("kernel.latency", "cycle");
+static const Statistics::Histogram stat_kernel_queue   = Statistics::instance().histogram("kernel.queue", "cycle");     // from the launch to the first block
+
+static const Statistics::Counter   stat_stream_false_dependency = Statistics::instance().counter("stream.false_dependency");  // the kernels blocked by another stream
+static const vector<Statistics::Histogram> stat_stream_latency  = [](){
+    vector<Statistics::Histogram> histograms;
+    for (int level = 0; level < STREAM_PRIORITY_LEVEL; level++) histograms.push_back(Statistics::instance().histogram("stream.latency.priority" + to_string(level), "cycle"));
+    return histograms;
+}();
 
 /** ===============================================================================================
  * \name    GPU
@@ -15,16 +33,17 @@
  * \brief   The class of the GPU
  * 
  * \param   mc      the pointer of memory controller
+ * \param   gpu_id  the index of the GPU in the node
  * 
  * \endcond
  * ================================================================================================
  */
-GPU::GPU(MemoryController* mc) : mMC(mc), mGMMU(GMMU(this, mc))
+GPU::GPU(MemoryController* mc, int gpu_id) : gpuID(gpu_id), mMC(mc), mGMMU(GMMU(this, mc, gpu_id))
 {
-    /* Create SMs */
+    /* Create SMs, indexed in the GPU */
     for (int i = 0; i < system_resource.SM_NUM; i++)
     {
-        mSMs.insert(make_pair(i, SM()));
+        mSMs.insert(make_pair(i, SM(i)));
         mSMs[i].setGMMU(&mGMMU);
     }
 }
@@ -93,30 +112,81 @@ GPU::Runtime_Block_Scheduling()
 #if (LOG_LEVEL >= TRACE)
     log_T("GPU", "Runtime_Block_Scheduling");
 #endif
-    /* Iterate all kernels inside the command Queue */
-    list<Kernel*>  remainingQueue = {};
-    for (auto kernel : commandQueue)
+    /* The queued kernels behind their streams and hardware queues wait */
+    unordered_set<Kernel*> blocked_kernels;
+    if (command.HW_QUEUE_NUM) Stream_Dependency(blocked_kernels);
+
+    /* The running kernels bind their remaining blocks first, then the queued kernels, in the launch 
+     * order within the same stream priority */
+    vector<Kernel*> kernels;
+    for (auto kernel : runningKernels) if (dispatchKernels.count(kernel)) kernels.push_back(kernel);
+    for (auto kernel : commandQueue)   if (!blocked_kernels.count(kernel)) kernels.push_back(kernel);
+    stable_sort(kernels.begin(), kernels.end(), [this](Kernel* a, Kernel* b){return getStreamPriority(a) > getStreamPriority(b);});
+
+    unordered_set<Kernel*> launched_kernels;
+    for (auto kernel : kernels)
     {
         ASSERT(kernel, "Receive null kernel ptr");
 
-        bool sm_ready = true;
-        for (auto sm_id : *kernel->SM_List) sm_ready &= mSMs[sm_id].isIdel();
+        if (dispatchKernels.count(kernel))
+        {
+            Incremental_Block_Dispatch(kernel);
+            continue;
+        }
+
+        /* The incremental dispatch starts the kernel once any of its SMs admits a block */
+        bool sm_ready = command.DISPATCH_MODE == STATIC_DISPATCH;
+        for (auto sm_id : *kernel->SM_List)
+        {
+            if (command.DISPATCH_MODE == STATIC_DISPATCH) sm_ready &= isSMReady(sm_id, kernel);
+            else sm_ready |= isSMReady(sm_id, kernel);
+        }
 
         if (sm_ready)
         {
-            int division_count = kernel->SM_List->size() * GPU_MAX_WARP_PER_SM / GPU_MAX_WARP_PER_BLOCK;
+            if (command.MEMO_MODE != NO_MEMO && Memo_Kernel_Replay(kernel));
+            else if (command.FIDELITY_MODE == ANALYTIC) Analytic_Kernel_Launch(kernel);
+            else if (command.DISPATCH_MODE == INCREMENTAL_DISPATCH)
+            {
+                /* The blocks are sized as if the SMs were idle */
+                int division_count = kernel->SM_List->size() * mSMs[*kernel->SM_List->begin()].idleBlocks(kernel);
+                if (command.OCCUPANCY) division_count = min(division_count, (int)ceil((double)kernel->requests.size() / kernel->getBlockResource().threads));
+
+                dispatchKernels[kernel] = ceil((float)kernel->requests.size() / division_count);
+                Incremental_Block_Dispatch(kernel);
+            }
+            else if (command.DISPATCH_MODE == DYNAMIC_DISPATCH)
+            {
+                /* The logical blocks run DYNAMIC_BLOCK_ROUND rounds of requests, the SMs pull the 
+                 * next ones as their blocks finish */
+                dispatchKernels[kernel] = mSMs[*kernel->SM_List->begin()].getBlockResource(kernel).threads * DYNAMIC_BLOCK_ROUND;
+                Incremental_Block_Dispatch(kernel);
+            }
+            else
+            {
+                map<int, int> sm_blocks;
+                int division_count = 0;
+                for (auto sm_id : *kernel->SM_List) division_count += (sm_blocks[sm_id] = mSMs[sm_id].admitBlocks(kernel));
+                if (command.OCCUPANCY) division_count = Block_Split(sm_blocks, ceil((double)kernel->requests.size() / kernel->getBlockResource().threads));
 
-            int num_of_request = ceil((float)kernel->requests.size() / division_count);
-            for (auto sm_id : *kernel->SM_List) mSMs[sm_id].bindKernel(kernel, num_of_request);
+                int num_of_request = (command.FIDELITY_MODE == SAMPLED) ? Sampled_Kernel_Split(kernel, division_count)
+                                   : ceil((float)kernel->requests.size() / division_count);
+                for (auto sm_id : *kernel->SM_List) mSMs[sm_id].bindKernel(kernel, num_of_request, sm_blocks[sm_id]);
+            }
             
-            ASSERT(kernel->requests.empty(), "error");
+            ASSERT(kernel->requests.empty() || dispatchKernels.count(kernel), "error");
+
+            if (trace_recorder) trace_recorder->launchKernel(kernel);
+
+            stat_kernel_queue.record(total_gpu_cycle - kernel->startCycle);
+            if (falseDependencies.erase(kernel)) stat_stream_false_dependency.add();
             
             runningKernels.push_back(kernel);
+            launched_kernels.insert(kernel);
         }
-        else remainingQueue.push_back(kernel);
     }
     
-    commandQueue = remainingQueue;
+    commandQueue.remove_if([&launched_kernels](Kernel* k){return launched_kernels.count(k);});
 
 #if (LOG_LEVEL >= VERBOSE)
     for (auto kernel: runningKernels) log_V("running kernel id", to_string(kernel->kernelID));
@@ -142,12 +212,36 @@ GPU::Check_Finish_Kernel()
     for (auto kernel : runningKernels)
     {
         bool finish = true;
-        for (auto sm_id : *kernel->SM_List) finish &= mSMs[sm_id].checkKernelComplete(kernel);
+        auto analytic = analyticKernels.find(kernel);
+        if (analytic != analyticKernels.end()) finish = analytic->second <= total_gpu_cycle;
+        else for (auto sm_id : *kernel->SM_List) finish &= mSMs[sm_id].checkKernelComplete(kernel);
+        finish &= !dispatchKernels.count(kernel);
+
+        /* The sampled blocks finish, fast-forward the skipped requests */
+        if (finish && sampledKernels.count(kernel))
+        {
+            Sampled_Kernel_Extrapolate(kernel);
+            analytic = analyticKernels.find(kernel);
+            finish   = analytic->second <= total_gpu_cycle;
+        }
         
         if (finish) 
         {
+            if (analytic != analyticKernels.end())
+            {
+                for (auto sm_id : *kernel->SM_List) analyticSMs.erase(sm_id);
+                analyticKernels.erase(analytic);
+            }
             kernel->endCycle = total_gpu_cycle;
             finishedKernels.push_back(kernel);
+
+            stat_kernel_finish.add();
+            stat_kernel_latency.record(kernel->endCycle - kernel->startCycle);
+            stat_stream_latency[getStreamPriority(kernel)].record(kernel->endCycle - kernel->startCycle);
+
+            if (trace_recorder) trace_recorder->finishKernel(kernel);
+
+            if (memoKernels.count(kernel)) Memo_Kernel_Record(kernel);
         }
     }
 
@@ -210,11 +304,27 @@ GPU::terminateModel (int app_id, int model_id)
         {
             for (auto& sm : mSMs) sm.second.terminateKernel(kernel);
             kernel->running = false;
+
+            if (analyticKernels.erase(kernel)) for (auto sm_id : *kernel->SM_List) analyticSMs.erase(sm_id);
+
+            if (sampledKernels.count(kernel))
+            {
+                for (auto request : sampledKernels[kernel].skipped_requests) delete request;
+                sampledKernels.erase(kernel);
+            }
+
+            memoKernels.erase(kernel);
+
+            if (dispatchKernels.erase(kernel))
+            {
+                while (!kernel->requests.empty()) delete kernel->accessRequest();
+            }
         }
     }
     runningKernels.remove_if([](Kernel* k){return !k->running;});
 
     /* Release commandQueue */
+    for (auto kernel : commandQueue) if (kernel->modelID == model_id) falseDependencies.erase(kernel);
     commandQueue.remove_if([model_id](Kernel* k){return !k->modelID == model_id;});
 
     return true;
@@ -254,7 +364,750 @@ GPU::getIdleSMs()
 {
     unordered_set<int> available_list = {};
     
-    for (auto& sm : mSMs) if (sm.second.isIdel()) available_list.insert(sm.first);    
+    for (auto& sm : mSMs) if (isSMIdle(sm.first)) available_list.insert(sm.first);    
 
     return available_list;
-}
\ No newline at end of file
+}
+
+
+/** ===============================================================================================
+ * \name    isSMIdle
+ * 
+ * \brief   Check whether the SM has no running block and is not held by an analytic kernel
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+bool
+GPU::isSMIdle(int sm_id)
+{
+    return mSMs[sm_id].isIdel() && !analyticSMs.count(sm_id);
+}
+
+
+/** ===============================================================================================
+ * \name    isSMReady
+ * 
+ * \brief   Check whether the SM admits a block of the kernel and is not held by an analytic kernel
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+bool
+GPU::isSMReady(int sm_id, Kernel* kernel)
+{
+    return mSMs[sm_id].admitBlocks(kernel) > 0 && !analyticSMs.count(sm_id);
+}
+
+
+/** ===============================================================================================
+ * \name    Block_Split
+ * 
+ * \brief   Spread the blocks of the kernel over its SMs in turn, up to the blocks admitted by each
+ *          SM, the rest of the SM resource is left to the other kernels
+ * 
+ * \param   sm_blocks       the blocks admitted by each SM, updated to the blocks bound to each SM
+ * \param   num_of_block    the blocks the kernel needs
+ * 
+ * \return  the number of blocks bound
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+int
+GPU::Block_Split(map<int, int>& sm_blocks, int num_of_block)
+{
+    map<int, int> split;
+    int division_count = 0;
+    for (bool more = true; more && division_count < num_of_block;)
+    {
+        more = false;
+        for (auto& sm_pair : sm_blocks)
+        {
+            if (division_count == num_of_block || split[sm_pair.first] == sm_pair.second) continue;
+
+            split[sm_pair.first]++;
+            division_count++;
+            more = true;
+        }
+    }
+
+    sm_blocks = split;
+    return division_count;
+}
+
+
+/** ===============================================================================================
+ * \name    Incremental_Block_Dispatch
+ * 
+ * \brief   Bind the blocks of the kernel to its SMs admitting them now, the kernel leaves the
+ *          dispatch once its requests are all bound. The incremental and the dynamic dispatch
+ *          differ in the requests of each block only.
+ * 
+ * \param   kernel  the running kernel with requests left
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+GPU::Incremental_Block_Dispatch(Kernel* kernel)
+{
+    int num_of_request = dispatchKernels.at(kernel);
+
+    map<int, int> sm_blocks;
+    for (auto sm_id : *kernel->SM_List) if (isSMReady(sm_id, kernel)) sm_blocks[sm_id] = mSMs[sm_id].admitBlocks(kernel);
+    Block_Split(sm_blocks, ceil((double)kernel->requests.size() / num_of_request));
+
+    for (auto& sm_pair : sm_blocks) mSMs[sm_pair.first].bindKernel(kernel, num_of_request, sm_pair.second);
+
+    if (kernel->requests.empty()) dispatchKernels.erase(kernel);
+}
+
+
+/** ===============================================================================================
+ * \name    Stream_Dependency
+ * 
+ * \brief   Find the queued kernels not dispatched in this cycle. The kernels of an application 
+ *          form its stream, the stream is mapped onto the hardware queue (appID % HW_QUEUE_NUM).
+ * 
+ * \note    * The kernel waits for the running kernel of its stream to finish.
+ * 
+ * \note    * Only the front kernel of the hardware queue is dispatched, after the kernel before it
+ *          binds all its blocks. The kernel behind the kernel of another stream waits as well, the
+ *          false dependency of the streams sharing the hardware queue.
+ * 
+ * \param   blocked_kernels     the queued kernels waiting
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+GPU::Stream_Dependency(unordered_set<Kernel*>& blocked_kernels)
+{
+    /* key: hardware queue, value: the stream of the kernel at its front */
+    unordered_map<int, int> queue_fronts;
+    unordered_set<int> running_streams;
+    for (auto kernel : runningKernels)
+    {
+        running_streams.insert(kernel->appID);
+        if (dispatchKernels.count(kernel)) queue_fronts[kernel->appID % command.HW_QUEUE_NUM] = kernel->appID;
+    }
+
+    for (auto kernel : commandQueue)
+    {
+        int queue_id = kernel->appID % command.HW_QUEUE_NUM;
+        auto front = queue_fronts.find(queue_id);
+
+        if (running_streams.count(kernel->appID)) blocked_kernels.insert(kernel);
+        else if (front != queue_fronts.end())
+        {
+            blocked_kernels.insert(kernel);
+            if (front->second != kernel->appID) falseDependencies.insert(kernel);
+        }
+
+        if (front == queue_fronts.end()) queue_fronts[queue_id] = kernel->appID;
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    getStreamPriority
+ * 
+ * \brief   The priority level of the stream of the kernel, 0 by default
+ * 
+ * \param   kernel  the kernel
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+int
+GPU::getStreamPriority(Kernel* kernel) const
+{
+    auto priority = command.STREAM_PRIORITY.find(kernel->appID);
+    return (priority != command.STREAM_PRIORITY.end()) ? priority->second : 0;
+}
+
+
+/** ===============================================================================================
+ * \name    forEachAccess
+ * 
+ * \brief   Split the request into the accesses as the warp does, each access carries up to
+ *          GPU_MAX_ACCESS_NUMBER addresses
+ * 
+ * \param   request     the request
+ * \param   visit       called by (access index, page id, is write) of each page of the accesses
+ * 
+ * \return  number of accesses
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+template <typename Visit>
+static unsigned long long
+forEachAccess(Request* request, Visit&& visit)
+{
+    unsigned long long step = 0;
+    for (auto pages : {&request->readPages, &request->writePages})
+    {
+        int budget = GPU_MAX_ACCESS_NUMBER;
+        for (auto& page_pair : *pages)
+        {
+            for (int count = page_pair.second; count > 0;)
+            {
+                if (budget == 0) {step++; budget = GPU_MAX_ACCESS_NUMBER;}
+
+                int access_count = min(count, budget);
+                visit(step, page_pair.first, pages == &request->writePages);
+                count -= access_count;
+                budget -= access_count;
+            }
+        }
+        if (budget != GPU_MAX_ACCESS_NUMBER) step++;
+    }
+    return step;
+}
+
+
+/** ===============================================================================================
+ * \name    Analytic_Kernel_Launch
+ * 
+ * \brief   Estimate the kernel duration instead of binding it to the SMs. The duration is bounded
+ *          by the request chain of each thread, the memory controller bandwidth and the page faults
+ *          predicted from the CGroup capacity.
+ * 
+ * \param   kernel  the kernel going to launch on its SM_List
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+GPU::Analytic_Kernel_Launch(Kernel* kernel)
+{
+    /* *******************************************************************
+     * Split the requests into the accesses as the warps do, the request
+     * r runs on the thread (r % thread number) in the round
+     * (r / thread number), its k-th access is issued in the wave
+     * (round, k)
+     * *******************************************************************
+     */
+    vector<Request*> requests;
+    while (!kernel->requests.empty()) requests.emplace_back(kernel->accessRequest());
+
+    unsigned long long num_of_request = requests.size(), num_of_access = 0;
+    unsigned long long num_of_thread  = min(num_of_request, (unsigned long long)kernel->SM_List->size() * GPU_MAX_WARP_PER_SM * GPU_MAX_THREAD_PER_WARP);
+
+    /* The wave first touching the page, the accesses are recorded as the memory controller does */
+    unordered_map<unsigned long long, pair<unsigned long long, unsigned long long>> first_wave;
+    vector<unsigned long long> page_list;
+    for (unsigned long long r = 0; r < num_of_request; r++)
+    {
+        num_of_access += forEachAccess(requests[r], [&](unsigned long long step, unsigned long long page_id, bool write) {
+            Page* page = mMC->refer(page_id);
+            write ? page->record.write_counter++ : page->record.read_counter++;
+            page->record.access_count++;
+            page->dirty |= write;
+
+            pair<unsigned long long, unsigned long long> wave = {r / num_of_thread, step};
+            auto it = first_wave.find(page_id);
+            if (it == first_wave.end())
+            {
+                first_wave.emplace(page_id, wave);
+                page_list.emplace_back(page_id);
+            }
+            else it->second = min(it->second, wave);
+        });
+    }
+
+    /* *******************************************************************
+     * Page faults predicted from the CGroup, the working set over the
+     * capacity is faulted again while the kernel is running
+     * *******************************************************************
+     */
+    unordered_set<unsigned long long> missing_pages;
+    for (auto page_id : page_list) if (!mGMMU.getCGroup(kernel->appID)->lookup(page_id)) missing_pages.insert(page_id);
+
+    unsigned long long capacity = mGMMU.getCGroupCapacity(kernel->appID);
+    auto migrate_count = mGMMU.migratePages(kernel->appID, page_list);
+    unsigned long long num_of_thrash = (page_list.size() > capacity) ? page_list.size() - capacity : 0;
+    unsigned long long num_of_fault  = migrate_count.first + num_of_thrash;
+
+    /* The faults of a thread are handled in different batches, the first toucher of the missing 
+     * page waits for a batch. The threads without faults run ahead, their faults are merged. */
+    unsigned long long num_of_batch = 0;
+    if (!missing_pages.empty())
+    {
+        vector<unsigned long long> thread_batches(num_of_thread, 0);
+        for (unsigned long long r = 0; r < num_of_request; r++)
+        {
+            long long fault_step = -1;
+            forEachAccess(requests[r], [&](unsigned long long step, unsigned long long page_id, bool write) {
+                if ((long long)step == fault_step || !missing_pages.count(page_id)) return;
+                if (first_wave[page_id] != make_pair(r / num_of_thread, step)) return;
+
+                fault_step = step;
+                num_of_batch = max(num_of_batch, ++thread_batches[r % num_of_thread]);
+            });
+        }
+    }
+    num_of_batch = max(num_of_batch, (unsigned long long)ceil((double)migrate_count.first / MSHR_STACK_SIZE))
+                 + ceil((double)num_of_thrash / MSHR_STACK_SIZE);
+
+    for (auto request : requests) delete request;
+
+    /* *******************************************************************
+     * Bounds of the duration (unit: GPU cycle), the threads run their
+     * requests in rounds, the memory controller serves one access per
+     * cycle and the page fault handler migrates the pages in batches
+     * *******************************************************************
+     */
+    double compute_cycle = ceil((double)num_of_request / num_of_thread)
+                         * ((double)kernel->getKernelInfo().numOfCycle + num_of_access * ANALYTIC_ACCESS_CYCLE) / num_of_request;
+    if (command.WARP_SCHEDULER_MODE != UNLIMITED_ISSUE)
+    {
+        /* The warp schedulers issue a part of the resident warps in each cycle */
+        double resident_warps = ceil((double)num_of_thread / GPU_MAX_THREAD_PER_WARP / kernel->SM_List->size());
+        compute_cycle *= max(1.0, resident_warps / (GPU_WARP_SCHEDULER_PER_SM * GPU_ISSUE_WIDTH));
+    }
+    double memory_cycle  = num_of_access * GPU_F / MC_F;
+    double batch_cycle   = num_of_batch * PAGE_FAULT_COMMUNICATION_CYCLE * GPU_F / GMMU_F;
+    double migrate_cycle = (num_of_fault + migrate_count.second) * PAGE_FAULT_MIGRATION_UNIT_CYCLE * GPU_F / GMMU_F;
+
+    /* The memory controller and the PCIe migration are shared by the running kernels, the faults
+     * of the concurrent kernels are merged into the same batches */
+    unsigned long long now = total_gpu_cycle;
+    if (memory_cycle > 0)  mc_free_cycle    = max(mc_free_cycle, now) + ceil(memory_cycle);
+    if (migrate_cycle > 0) fault_free_cycle = max(fault_free_cycle, now) + ceil(migrate_cycle);
+    double memory_delay = (memory_cycle > 0) ? mc_free_cycle - now : 0;
+    double fault_delay  = (migrate_cycle > 0) ? fault_free_cycle - now + batch_cycle : 0;
+
+    /* The computation overlaps the memory accesses, but stalls on the page faults */
+    double estimate = max(1.0, max(compute_cycle, memory_delay) + fault_delay);
+    double lower    = max({compute_cycle, memory_delay, fault_delay});
+    double upper    = compute_cycle + memory_delay + fault_delay;
+
+    analyticKernels[kernel] = now + (unsigned long long)ceil(estimate);
+    for (auto sm_id : *kernel->SM_List) analyticSMs.insert(sm_id);
+
+    analytic_record.kernel_count++;
+    analytic_record.estimate_cycle += estimate;
+    analytic_record.lower_cycle    += lower;
+    analytic_record.upper_cycle    += upper;
+    analytic_record.max_lower_error = max(analytic_record.max_lower_error, (estimate - lower) / estimate);
+    analytic_record.max_upper_error = max(analytic_record.max_upper_error, (upper - estimate) / estimate);
+
+#if (PRINT_SM_ALLCOATION_RESULT)
+    std::cout << "Estimate kernel:" << kernel->kernelID << " on SMs: " << kernel->SM_List->size() << " with cycles: " << (unsigned long long)ceil(estimate)
+              << " [compute: " << compute_cycle << ", memory: " << memory_delay << ", fault: " << fault_delay << " (" << num_of_fault << " pages, " << num_of_batch << " batches)]" << std::endl;
+#endif
+}
+
+
+/** ===============================================================================================
+ * \name    Sampled_Kernel_Split
+ * 
+ * \brief   Keep the first rounds of requests of each block for the detailed simulation, the other
+ *          requests are skipped until the sampled blocks finish. The kernel with one round of
+ *          requests per block is simulated in full.
+ * 
+ * \param   kernel          the kernel going to bind to the SMs
+ * \param   division_count  the number of blocks of the kernel
+ * 
+ * \return  the number of requests of each block
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+int
+GPU::Sampled_Kernel_Split(Kernel* kernel, int division_count)
+{
+    int num_of_request = ceil((float)kernel->requests.size() / division_count);
+    int block_thread   = GPU_MAX_WARP_PER_BLOCK * GPU_MAX_THREAD_PER_WARP;
+    int num_of_round   = ceil((float)num_of_request / block_thread);
+    int sampled_round  = ceil(num_of_round * command.SAMPLE_RATE);
+    if (sampled_round >= num_of_round) return num_of_request;
+
+    int sampled_request = sampled_round * block_thread;
+
+    auto& record = sampledKernels[kernel];
+    vector<Request*> sampled_requests;
+    for (int index = 0; !kernel->requests.empty(); index++)
+    {
+        Request* request = kernel->accessRequest();
+        (index % num_of_request < sampled_request) ? sampled_requests.emplace_back(request) : record.skipped_requests.emplace_back(request);
+    }
+    for (auto request : sampled_requests) kernel->requests.push(request);
+
+    /* The pages faulted by the sampled requests */
+    auto TLB = mGMMU.getCGroup(kernel->appID);
+    unordered_set<unsigned long long> fault_pages;
+    for (auto request : sampled_requests)
+    {
+        forEachAccess(request, [&](unsigned long long step, unsigned long long page_id, bool write) {
+            if (!TLB->lookup(page_id)) fault_pages.insert(page_id);
+        });
+    }
+
+    record.sampled_request   = sampled_requests.size();
+    record.fault_page        = fault_pages.size();
+    record.start_cycle       = total_gpu_cycle;
+    record.start_fault_cycle = mGMMU.getFaultHandlerCycle();
+
+    return sampled_request;
+}
+
+
+/** ===============================================================================================
+ * \name    Sampled_Kernel_Extrapolate
+ * 
+ * \brief   Fast-forward the skipped requests of the finished sampled blocks. The pages are updated
+ *          functionally so the later kernels see the working set, the duration is extrapolated
+ *          from the cycles per request and the cycles per fault page of the sampled blocks. The
+ *          kernel holds its SMs as an analytic kernel until the extrapolated finish cycle.
+ * 
+ * \param   kernel  the kernel whose sampled blocks are finished
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+GPU::Sampled_Kernel_Extrapolate(Kernel* kernel)
+{
+    auto& record = sampledKernels.at(kernel);
+
+    auto migrate_count = mGMMU.migratePages(kernel->appID, recordAccesses(record.skipped_requests));
+
+    /* *******************************************************************
+     * Extrapolate the computation by the requests and the page faults by
+     * the fault pages, the fault handler time is shared by the kernels
+     * *******************************************************************
+     */
+    double sampled_cycle = total_gpu_cycle - record.start_cycle;
+    double fault_cycle   = min(sampled_cycle, (mGMMU.getFaultHandlerCycle() - record.start_fault_cycle) * GPU_F / GMMU_F);
+    double request_cycle = (sampled_cycle - fault_cycle) / record.sampled_request;
+
+    double skipped_fault_cycle = 0;
+    if (migrate_count.first)
+    {
+        skipped_fault_cycle = record.fault_page ? fault_cycle / record.fault_page * migrate_count.first
+                            : (PAGE_FAULT_COMMUNICATION_CYCLE + (migrate_count.first + migrate_count.second) * PAGE_FAULT_MIGRATION_UNIT_CYCLE) * GPU_F / GMMU_F;
+    }
+    double estimate = request_cycle * record.skipped_requests.size() + skipped_fault_cycle;
+
+    /* The 95% confidence interval of the mean block duration */
+    double sum = 0, square_sum = 0, n = kernel->block_record.size();
+    for (auto& block : kernel->block_record)
+    {
+        double duration = block.end_cycle - block.start_cycle;
+        sum += duration;
+        square_sum += duration * duration;
+    }
+    double mean = (n > 0) ? sum / n : 0;
+    double deviation  = (n > 1) ? sqrt(max(0.0, (square_sum - n * mean * mean) / (n - 1))) : 0;
+    double confidence = (mean > 0) ? 1.96 * deviation / sqrt(n) / mean : 0;
+
+    stringstream buff;
+    buff << std::fixed << std::setprecision(2)
+         << "Sampled kernel: " << kernel->kernelID
+         << ", requests: " << record.sampled_request << "/" << record.sampled_request + record.skipped_requests.size()
+         << ", sampled: " << (unsigned long long)sampled_cycle << " cycles (" << record.fault_page << " fault pages)"
+         << ", extrapolated: " << (unsigned long long)ceil(estimate) << " cycles (" << migrate_count.first << " fault pages)"
+         << ", confidence: ";
+    (n > 1) ? buff << "+-" << 100 * confidence << "%" : buff << "n/a";
+    buff << " (" << (int)n << " blocks)" << std::endl;
+
+    std::cout << buff.str();
+    LogStream file;
+        file << buff.str();
+    file.close();
+
+    analyticKernels[kernel] = total_gpu_cycle + (unsigned long long)ceil(estimate);
+    for (auto sm_id : *kernel->SM_List) analyticSMs.insert(sm_id);
+
+    for (auto request : record.skipped_requests) delete request;
+    sampledKernels.erase(kernel);
+}
+
+
+/** ===============================================================================================
+ * \name    Memo_Kernel_Replay
+ * 
+ * \brief   Replay the recorded duration of the identical kernel launch, the pages are updated
+ *          functionally and the kernel holds its SMs as an analytic kernel until the recorded
+ *          duration passes. The missed launch is simulated and recorded when it finishes.
+ * 
+ * \param   kernel  the kernel going to launch on its SM_List
+ * 
+ * \return  true if the kernel is replayed
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+bool
+GPU::Memo_Kernel_Replay(Kernel* kernel)
+{
+    vector<Request*> requests;
+    while (!kernel->requests.empty()) requests.emplace_back(kernel->accessRequest());
+
+    /* *******************************************************************
+     * The key of the launch, the resident fraction of the kernel pages
+     * in the CGroup and the layers running on the other SMs. Only the
+     * fully resident kernel has the top bucket, a single page fault
+     * costs a whole fault batch.
+     * *******************************************************************
+     */
+    auto TLB = mGMMU.getCGroup(kernel->appID);
+    unordered_set<unsigned long long> page_set;
+    unsigned long long resident_count = 0;
+    for (auto request : requests)
+    {
+        for (auto pages : {&request->readPages, &request->writePages})
+        {
+            for (auto& page_pair : *pages) if (page_set.insert(page_pair.first).second) resident_count += TLB->lookup(page_pair.first);
+        }
+    }
+
+    MemoKey key;
+    key.signature       = kernel->getSignature();
+    key.batch_size      = kernel->getBatchSize();
+    key.sm_count        = kernel->SM_List->size();
+    key.resident_bucket = page_set.empty() ? MEMO_RESIDENT_BUCKET 
+                        : MEMO_RESIDENT_BUCKET - ceil((double)(page_set.size() - resident_count) * MEMO_RESIDENT_BUCKET / page_set.size());
+    for (auto running : runningKernels) key.co_runners.emplace_back(running->getSignature());
+    sort(key.co_runners.begin(), key.co_runners.end());
+
+    /* The strict mode simulates the first replay of the record and every MEMO_VERIFY_INTERVAL-th
+     * replay after it, the simulated duration is compared with the record */
+    auto entry  = memoTable.find(key);
+    bool verify = entry != memoTable.end() && command.MEMO_MODE == STRICT_MEMO && entry->second.replay_count % MEMO_VERIFY_INTERVAL == 0;
+
+    if (entry == memoTable.end() || verify)
+    {
+        if (entry != memoTable.end()) entry->second.replay_count++;
+        else memo_record.miss_count++;
+
+        for (auto request : requests) kernel->requests.push(request);
+        memoKernels[kernel] = {key, total_gpu_cycle, verify};
+        return false;
+    }
+
+    /* *******************************************************************
+     * Replay
+     * *******************************************************************
+     */
+    mGMMU.migratePages(kernel->appID, recordAccesses(requests));
+    for (auto request : requests) delete request;
+
+    auto& memo = entry->second;
+    memo.replay_count++;
+    memo_record.hit_count++;
+
+    vector<int> sm_list(kernel->SM_List->begin(), kernel->SM_List->end());
+    sort(sm_list.begin(), sm_list.end());
+    for (auto block : memo.block_record)
+    {
+        block.sm_id = sm_list[find(memo.sm_list.begin(), memo.sm_list.end(), block.sm_id) - memo.sm_list.begin()];
+        block.start_cycle += total_gpu_cycle;
+        block.end_cycle   += total_gpu_cycle;
+        for (auto& warp : block.warp_record)
+        {
+            warp.start_cycle += total_gpu_cycle;
+            warp.end_cycle   += total_gpu_cycle;
+        }
+        kernel->block_record.emplace_back(move(block));
+    }
+
+    analyticKernels[kernel] = total_gpu_cycle + memo.duration;
+    for (auto sm_id : *kernel->SM_List) analyticSMs.insert(sm_id);
+
+#if (PRINT_SM_ALLCOATION_RESULT)
+    std::cout << "Replay kernel:" << kernel->kernelID << " on SMs: " << kernel->SM_List->size() << " with cycles: " << memo.duration << std::endl;
+#endif
+
+    return true;
+}
+
+
+/** ===============================================================================================
+ * \name    Memo_Kernel_Record
+ * 
+ * \brief   Record the duration and the block records of the simulated kernel, or compare them with
+ *          the record if the kernel verifies it
+ * 
+ * \param   kernel  the finished kernel launched by Memo_Kernel_Replay
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+GPU::Memo_Kernel_Record(Kernel* kernel)
+{
+    auto launch = memoKernels.at(kernel);
+    memoKernels.erase(kernel);
+
+    unsigned long long duration = kernel->endCycle - launch.launch_cycle;
+    if (launch.verify)
+    {
+        auto& memo  = memoTable.at(launch.key);
+        double error = ((double)memo.duration - duration) / max(duration, 1ULL);
+
+        memo_record.verify_count++;
+        memo_record.max_verify_error = max(memo_record.max_verify_error, fabs(error));
+
+        stringstream buff;
+        buff << std::fixed << std::setprecision(2)
+             << "Verify memo kernel: " << kernel->kernelID
+             << ", recorded: " << memo.duration << " cycles"
+             << ", simulated: " << duration << " cycles"
+             << ", error: " << 100 * error << "%" << std::endl;
+
+        std::cout << buff.str();
+        LogStream file;
+            file << buff.str();
+        file.close();
+        return;
+    }
+
+    auto& memo = memoTable[launch.key];
+    memo.duration = duration;
+    memo.sm_list  = vector<int>(kernel->SM_List->begin(), kernel->SM_List->end());
+    sort(memo.sm_list.begin(), memo.sm_list.end());
+    for (auto block : kernel->block_record)
+    {
+        block.start_cycle -= launch.launch_cycle;
+        block.end_cycle   -= launch.launch_cycle;
+        for (auto& warp : block.warp_record)
+        {
+            warp.start_cycle -= launch.launch_cycle;
+            warp.end_cycle   -= launch.launch_cycle;
+        }
+        memo.block_record.emplace_back(move(block));
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    recordAccesses
+ * 
+ * \brief   Record the accesses of the requests without simulating them, as the memory controller
+ *          does
+ * 
+ * \param   requests    the requests going to be fast-forwarded
+ * 
+ * \return  the accessed pages in the order of the first access
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+vector<unsigned long long>
+GPU::recordAccesses(const vector<Request*>& requests)
+{
+    unordered_set<unsigned long long> page_set;
+    vector<unsigned long long> page_list;
+    for (auto request : requests)
+    {
+        forEachAccess(request, [&](unsigned long long step, unsigned long long page_id, bool write) {
+            Page* page = mMC->refer(page_id);
+            write ? page->record.write_counter++ : page->record.read_counter++;
+            page->record.access_count++;
+            page->dirty |= write;
+
+            if (page_set.insert(page_id).second) page_list.emplace_back(page_id);
+        });
+    }
+    return page_list;
+}
+
+
+/** ===============================================================================================
+ * \name    nextEventCycle
+ * 
+ * \brief   The cycle of the next GPU event, the analytic kernels leave the GPU idle until they
+ *          finish
+ * 
+ * \return  the current cycle if the GPU is simulated cycle by cycle, -1 if no event
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+unsigned long long
+GPU::nextEventCycle()
+{
+    if (!finishedKernels.empty() || !mGMMU.isIdle()) return total_gpu_cycle;
+
+    for (auto kernel : commandQueue)
+    {
+        bool sm_ready = true;
+        for (auto sm_id : *kernel->SM_List) sm_ready &= isSMReady(sm_id, kernel);
+        if (sm_ready) return total_gpu_cycle;
+    }
+
+    unsigned long long next_cycle = -1;
+    for (auto kernel : runningKernels)
+    {
+        auto analytic = analyticKernels.find(kernel);
+        if (analytic == analyticKernels.end()) return total_gpu_cycle;
+
+        next_cycle = min(next_cycle, analytic->second);
+    }
+
+    return next_cycle;
+}
+
+
+/** ===============================================================================================
+ * \name    printAnalyticRecord
+ * 
+ * \brief   Print the error bound of the analytic estimation, the duration lies between the fully
+ *          overlapped bound and the serialized bound
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+GPU::printAnalyticRecord()
+{
+    if (!analytic_record.kernel_count) return;
+
+    auto& record = analytic_record;
+    stringstream buff;
+    buff << std::fixed << std::setprecision(2)
+         << "Analytic kernels: " << record.kernel_count
+         << ", estimate: " << (unsigned long long)record.estimate_cycle << " cycles"
+         << ", bound: [-" << 100 * (record.estimate_cycle - record.lower_cycle) / record.estimate_cycle
+         << "%, +" << 100 * (record.upper_cycle - record.estimate_cycle) / record.estimate_cycle << "%]"
+         << ", worst kernel: [-" << 100 * record.max_lower_error << "%, +" << 100 * record.max_upper_error << "%]"
+         << std::endl;
+
+    std::cout << buff.str();
+    LogStream file;
+        file << buff.str();
+    file.close();
+}
+
+
+/** ===============================================================================================
+ * \name    printMemoRecord
+ * 
+ * \brief   Print the replayed and simulated kernels of the memoization, and the worst error of the
+ *          verified replays in the strict mode
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+GPU::printMemoRecord()
+{
+    if (command.MEMO_MODE == NO_MEMO) return;
+
+    auto& record = memo_record;
+    stringstream buff;
+    buff << std::fixed << std::setprecision(2)
+         << "Memo kernels: " << record.hit_count << " replayed, " << record.miss_count << " recorded, " << memoTable.size() << " entries";
+    if (command.MEMO_MODE == STRICT_MEMO) buff << ", verified: " << record.verify_count << " (max error: " << 100 * record.max_verify_error << "%)";
+    buff << std::endl;
+
+    std::cout << buff.str();
+    LogStream file;
+        file << buff.str();
+    file.close();
+}
@@ -0,0 +1,135 @@
+/**
+ * \name    HardwareConfig.cpp
+ * 
+ * \brief   Implement the hardware profile loader
+ * 
+ * \date    Oct 18, 2026
+ */
+
+#include "include/App_config.h"
+#include "include/Log.h"
+
+/* ************************************************************************************************
+ * Profile Field
+ * ************************************************************************************************
+ */
+static const map<string, int HardwareConfig::*> INT_FIELDS = {
+    {"page_size",               &HardwareConfig::page_size},
+    {"dram_channel_bandwidth",  &HardwareConfig::dram_channel_bandwidth},
+    {"dram_total_bandwidth",    &HardwareConfig::dram_total_bandwidth},
+    {"sm_num",                  &HardwareConfig::sm_num},
+    {"max_warp_per_sm",         &HardwareConfig::max_warp_per_sm},
+    {"max_warp_per_block",      &HardwareConfig::max_warp_per_block},
+    {"max_thread_per_warp",     &HardwareConfig::max_thread_per_warp},
+    {"max_block_per_sm",        &HardwareConfig::max_block_per_sm},
+    {"max_thread_per_block",    &HardwareConfig::max_thread_per_block},
+    {"max_access_number",       &HardwareConfig::max_access_number},
+    {"register_per_sm",         &HardwareConfig::register_per_sm},
+    {"l1_cache_size",           &HardwareConfig::l1_cache_size},
+    {"l1_cache_line_size",      &HardwareConfig::l1_cache_line_size},
+    {"l1_cache_way_number",     &HardwareConfig::l1_cache_way_number},
+    {"l2_cache_size",           &HardwareConfig::l2_cache_size},
+    {"l2_cache_line_size",      &HardwareConfig::l2_cache_line_size},
+    {"l2_cache_way_number",     &HardwareConfig::l2_cache_way_number},
+    {"warp_scheduler_per_sm",   &HardwareConfig::warp_scheduler_per_sm},
+    {"issue_width",             &HardwareConfig::issue_width},
+};
+
+static const map<string, double HardwareConfig::*> DOUBLE_FIELDS = {
+    {"pre_allocate_size",       &HardwareConfig::pre_allocate_size},
+    {"pcie_bandwidth",          &HardwareConfig::pcie_bandwidth},
+    {"peer_bandwidth",          &HardwareConfig::peer_bandwidth},
+    {"cpu_f",                   &HardwareConfig::cpu_f},
+    {"mc_f",                    &HardwareConfig::mc_f},
+    {"gpu_f",                   &HardwareConfig::gpu_f},
+    {"gmmu_f",                  &HardwareConfig::gmmu_f},
+    {"cpu_constant_power",      &HardwareConfig::cpu_constant_power},
+    {"dram_read_latency",       &HardwareConfig::dram_read_latency},
+    {"dram_write_latency",      &HardwareConfig::dram_write_latency},
+    {"dram_read_energy",        &HardwareConfig::dram_read_energy},
+    {"dram_write_energy",       &HardwareConfig::dram_write_energy},
+    {"dram_leakage_power",      &HardwareConfig::dram_leakage_power},
+    {"shared_memory_per_sm",    &HardwareConfig::shared_memory_per_sm},
+    {"gpu_idle_power",          &HardwareConfig::gpu_idle_power},
+    {"gpu_exec_power",          &HardwareConfig::gpu_exec_power},
+    {"page_fault_penalty",      &HardwareConfig::page_fault_penalty},
+    {"remote_access_latency",   &HardwareConfig::remote_access_latency},
+};
+
+
+/** ===============================================================================================
+ * \name    loadHardwareConfig
+ * 
+ * \brief   Load the builtin profile by name, or the profile file with "key = value" lines. The
+ *          keys not in the file keep the value of the builtin profile given by "base = name".
+ * 
+ * \param   profile     the builtin profile name (Xavier | Orin | A100) or the file path
+ * 
+ * \return  true if the profile is loaded
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+bool
+loadHardwareConfig (const string& profile)
+{
+    for (auto& builtin : {AGX_XAVIER, AGX_ORIN, A100})
+    {
+        if (strcasecmp(profile.c_str(), builtin.name) == 0)
+        {
+            hardware_config = builtin;
+            return true;
+        }
+    }
+
+    ifstream file(profile);
+    if (!file.is_open()) return false;
+
+    HardwareConfig config = HARDWARE_ARCHITECTURE;
+
+    /* The profile is named by the file name without extension */
+    string name = profile.substr(profile.find_last_of('/') + 1);
+    name = name.substr(0, name.find_last_of('.'));
+    strncpy(config.name, name.c_str(), sizeof(config.name) - 1);
+    config.name[sizeof(config.name) - 1] = '\0';
+
+    string line;
+    for (int line_num = 1; getline(file, line); line_num++)
+    {
+        /* Remove the comment and blank */
+        line = line.substr(0, line.find('#'));
+        line.erase(remove_if(line.begin(), line.end(), ::isspace), line.end());
+        if (line.empty()) continue;
+
+        auto pos = line.find('=');
+        ASSERT(pos != string::npos, profile + ":" + to_string(line_num) + ": expect \"key = value\"");
+
+        string key   = line.substr(0, pos);
+        string value = line.substr(pos + 1);
+
+        if (key == "base")
+        {
+            bool found = false;
+            for (auto& builtin : {AGX_XAVIER, AGX_ORIN, A100})
+            {
+                if (strcasecmp(value.c_str(), builtin.name) != 0) continue;
+
+                char config_name[sizeof(config.name)];
+                memcpy(config_name, config.name, sizeof(config_name));
+                config = builtin;
+                memcpy(config.name, config_name, sizeof(config_name));
+                found = true;
+            }
+            ASSERT(found, profile + ":" + to_string(line_num) + ": unknown base profile " + value);
+        }
+        else if (INT_FIELDS.count(key))    config.*INT_FIELDS.at(key)    = stoi(value);
+        else if (DOUBLE_FIELDS.count(key)) config.*DOUBLE_FIELDS.at(key) = stod(value);
+        else ASSERT(false, profile + ":" + to_string(line_num) + ": unknown key " + key);
+    }
+
+    ASSERT(config.page_size > 0 && config.max_warp_per_block > 0 && config.max_warp_per_sm >= config.max_warp_per_block
+        && config.warp_scheduler_per_sm > 0 && config.issue_width > 0, "Invalid hardware profile " + profile);
+
+    hardware_config = config;
+    return true;
+}
@@ -7,12 +7,7 @@
  */
 
 #include "include/Kernel.hpp"
-
-/* ************************************************************************************************
- * Global Variable
- * ************************************************************************************************
- */
-int Kernel::kernelCount = 0;
+#include "include/Timeline.hpp"
 
 /** ===============================================================================================
  * \name    Kernel
@@ -38,7 +33,7 @@ int Kernel::kernelCount = 0;
  * ================================================================================================
  */
 Kernel::Kernel(int app_id, int model_id, Layer* src_layer, vector<Kernel*> dependencies) 
-        : appID(app_id), modelID(model_id), kernelID(kernelCount++), srcLayer(src_layer), dependencyKernels(dependencies)
+        : appID(app_id), modelID(model_id), kernelID(sim_context->kernel_count++), srcLayer(src_layer), dependencyKernels(dependencies)
         , running(false), finish(false)
 {
     requests = {};
@@ -210,6 +205,43 @@ Kernel::isReady()
 }
 
 
+/** ===============================================================================================
+ * \name    getSignature
+ * 
+ * \brief   Identify the compiled kernel by the source layer and the requests, the same layer of
+ *          the periodic models has the same signature
+ * 
+ * \return  hash of the layer type, layer index and the kernel information
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+size_t
+Kernel::getSignature() const
+{
+    string buff = string(srcLayer->layerType) + "_" + to_string(srcLayer->layerID) 
+                + "_" + to_string(kernelInfo.numOfRequest) + "_" + to_string(kernelInfo.numOfRead) 
+                + "_" + to_string(kernelInfo.numOfWrite)   + "_" + to_string(kernelInfo.numOfCycle);
+
+    return hash<string>()(buff);
+}
+
+
+/** ===============================================================================================
+ * \name    getBlockResource
+ * 
+ * \brief   The resource of each block of the kernel, decided by the source layer
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+BlockResource
+Kernel::getBlockResource() const
+{
+    return srcLayer->getBlockResource();
+}
+
+
 /** ===============================================================================================
  * \name    handleKernelCompletion
  * 
@@ -226,11 +258,13 @@ Kernel::handleKernelCompletion()
     string buff = "[" + to_string(kernelID) + "] (" + srcLayer->layerType + "): [" + to_string(startCycle) + ", " + to_string(endCycle) + "]";
     log_W("Finish kernel", buff);
 
+    if (timeline) timeline->recordKernel(this, buff.substr(0, buff.find(':')));
+
     /* *******************************************************************
      * Record the kernel information into file
      * *******************************************************************
      */
-    ofstream file(LOG_OUT_PATH + program_name + ".txt", std::ios::app);
+    LogStream file;
     file << "Finish kernel " << buff << std::endl;
 #if (PRINT_BLOCK_RECORD)
     for (auto& b_record : block_record)
@@ -437,6 +471,8 @@ KernelGroup::handleKernelCompletion()
         buff += to_string(kernel.first->kernelID) + ", ";
         kernel.first->finish  = true;
         kernel.first->running = false;
+        kernel.first->startCycle = startCycle;
+        kernel.first->endCycle   = endCycle;
     //    *kernel.first->recorder += *recorder;
     }
     buff += "] (";
@@ -444,12 +480,14 @@ KernelGroup::handleKernelCompletion()
     buff += "): [" + to_string(startCycle) + ", " + to_string(endCycle) + "]";
 
     log_W("Finish kernelGroup", buff);
+
+    if (timeline) timeline->recordKernel(this, buff.substr(0, buff.find(':')));
     
     /* *******************************************************************
      * Record the kernel information into file
      * *******************************************************************
      */
-    ofstream file(LOG_OUT_PATH + program_name + ".txt", std::ios::app);
+    LogStream file;
     file << "Finish kernelGroup " << buff << std::endl;
 #if (PRINT_BLOCK_RECORD)
     for (auto& b_record : block_record)
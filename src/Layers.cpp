@@ -8,12 +8,6 @@
 
 #include "include/Layers.hpp"
 
-/* ************************************************************************************************
- * Global Variable
- * ************************************************************************************************
- */
-int Layer::vaCount = 0;
-
 /** ===============================================================================================
  * \name    Layer
  *
@@ -33,10 +27,10 @@ Layer::Layer(int layer_id, char* layer_type, vector<int> input_size, vector<int>
         : layerType(layer_type), iFMapSize(input_size), filterSize(filter_size), activationType(activation_type)
         , iFMap({}), filter({}), oFMapSize({}), oFMap({}), layerID(layer_id)
 {
-    // if (!iFMapSize.empty())  iFMap  = make_pair(++vaCount, new vector<DATA_TYPE> (iFMapSize[BATCH]  * iFMapSize[CHANNEL]  * iFMapSize[HEIGHT]  * iFMapSize[WIDTH]));
-    // if (!filterSize.empty()) filter = make_pair(++vaCount, new vector<DATA_TYPE> (filterSize[BATCH] * filterSize[CHANNEL] * filterSize[HEIGHT] * filterSize[WIDTH]));
-    if (!iFMapSize.empty())  iFMap  = make_pair(++vaCount, new vector<DATA_TYPE> (0));
-    if (!filterSize.empty()) filter = make_pair(++vaCount, new vector<DATA_TYPE> (0));
+    // if (!iFMapSize.empty())  iFMap  = make_pair(++sim_context->va_count, new vector<DATA_TYPE> (iFMapSize[BATCH]  * iFMapSize[CHANNEL]  * iFMapSize[HEIGHT]  * iFMapSize[WIDTH]));
+    // if (!filterSize.empty()) filter = make_pair(++sim_context->va_count, new vector<DATA_TYPE> (filterSize[BATCH] * filterSize[CHANNEL] * filterSize[HEIGHT] * filterSize[WIDTH]));
+    if (!iFMapSize.empty())  iFMap  = make_pair(++sim_context->va_count, new vector<DATA_TYPE> (0));
+    if (!filterSize.empty()) filter = make_pair(++sim_context->va_count, new vector<DATA_TYPE> (0));
 }
 
 
@@ -243,6 +237,21 @@ Layer::getMemoryUsage()
 }
 
 
+/** ===============================================================================================
+ * \name    getBlockResource
+ *
+ * \brief   The block of the layer copies the data without the shared memory
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+BlockResource
+Layer::getBlockResource() const
+{
+    return {min(OCCUPANCY_BLOCK_THREAD, GPU_MAX_THREAD_PER_BLOCK), 16, 0};
+}
+
+
 /** ===============================================================================================
  * \name    printInfo
  *
@@ -337,6 +346,7 @@ void*
 Layer::threadCompile(void* arg)
 {
     ThreadArg* threadArg = static_cast<ThreadArg*>(arg);
+    sim_context = threadArg->context;
 
 #if (LOG_LEVEL >= VERBOSE)
     pthread_mutex_lock ( ioMutex );
@@ -371,8 +381,8 @@ Conv2D::Conv2D(int layer_id, char* layer_type, vector<int> input_size, vector<in
 {
     calculateOFMapSize();
     // int size = oFMapSize[BATCH] * oFMapSize[CHANNEL] * oFMapSize[HEIGHT] * oFMapSize[WIDTH];
-    // oFMap = make_pair(++vaCount, new vector<DATA_TYPE>(size));
-    oFMap = make_pair(++vaCount, new vector<DATA_TYPE>(0));
+    // oFMap = make_pair(++sim_context->va_count, new vector<DATA_TYPE>(size));
+    oFMap = make_pair(++sim_context->va_count, new vector<DATA_TYPE>(0));
 }
 
 
@@ -478,6 +488,26 @@ Conv2D::printInfo()
 }
 
 
+/** ===============================================================================================
+ * \name    getBlockResource
+ *
+ * \brief   The block keeps the filter of its output channel in the shared memory and accumulates
+ *          the unrolled filter window in the registers
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+BlockResource
+Conv2D::getBlockResource() const
+{
+    BlockResource block = Layer::getBlockResource();
+    block.registers     = 64;
+    block.shared_memory = min((int)(filterSize[FILTER_CHANNEL_I] * filterSize[HEIGHT] * filterSize[WIDTH] * sizeof(DATA_TYPE)), OCCUPANCY_MAX_SHARED_MEMORY);
+
+    return block;
+}
+
+
 /** ===============================================================================================
  * \name    issueLayer
  *
@@ -594,8 +624,8 @@ Pooling::Pooling(int layer_id, vector<int> input_size, vector<int> _kernel, char
 {
     calculateOFMapSize();
     // int size = oFMapSize[BATCH] * oFMapSize[CHANNEL] * oFMapSize[HEIGHT] * oFMapSize[WIDTH];
-    // oFMap = make_pair(++vaCount, new vector<DATA_TYPE>(size));
-    oFMap = make_pair(++vaCount, new vector<DATA_TYPE>(0));
+    // oFMap = make_pair(++sim_context->va_count, new vector<DATA_TYPE>(size));
+    oFMap = make_pair(++sim_context->va_count, new vector<DATA_TYPE>(0));
 }
 
 
@@ -682,6 +712,24 @@ Pooling::printInfo()
 }
 
 
+/** ===============================================================================================
+ * \name    getBlockResource
+ *
+ * \brief   The block reduces the pooling window in the registers
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+BlockResource
+Pooling::getBlockResource() const
+{
+    BlockResource block = Layer::getBlockResource();
+    block.registers     = 32;
+
+    return block;
+}
+
+
 /** ===============================================================================================
  * \name    issueLayer
  *
@@ -785,8 +833,8 @@ Flatten::Flatten(int layer_id, vector<int> input_size) : Layer(layer_id, (char*)
 {
     calculateOFMapSize();
     // int size = oFMapSize[BATCH] * oFMapSize[CHANNEL] * oFMapSize[HEIGHT] * oFMapSize[WIDTH];
-    // oFMap = make_pair(++vaCount, new vector<DATA_TYPE>(size));
-    oFMap = make_pair(++vaCount, new vector<DATA_TYPE>(0));
+    // oFMap = make_pair(++sim_context->va_count, new vector<DATA_TYPE>(size));
+    oFMap = make_pair(++sim_context->va_count, new vector<DATA_TYPE>(0));
 }
 
 /** ===============================================================================================
@@ -920,8 +968,8 @@ ByPass::ByPass(int layer_id, vector<int> input_size)
     
     ASSERT(!iFMapSize.empty(), "Cannot calculate the size of OFMap due to missing parameter.");
     oFMapSize = iFMapSize;
-    // oFMap = make_pair(++vaCount, new vector<DATA_TYPE>(oFMapSize[BATCH] * oFMapSize[CHANNEL] * oFMapSize[HEIGHT] * oFMapSize[WIDTH]));
-    oFMap = make_pair(++vaCount, new vector<DATA_TYPE>(0));
+    // oFMap = make_pair(++sim_context->va_count, new vector<DATA_TYPE>(oFMapSize[BATCH] * oFMapSize[CHANNEL] * oFMapSize[HEIGHT] * oFMapSize[WIDTH]));
+    oFMap = make_pair(++sim_context->va_count, new vector<DATA_TYPE>(0));
 }
 
 
@@ -941,8 +989,8 @@ ByPass::ByPass(int layer_id, vector<int> input_size, vector<int> output_size)
 {
     ASSERT(!output_size.empty(), "Cannot calculate the size of OFMap due to missing parameter.");
     oFMapSize = output_size;
-    // oFMap = make_pair(++vaCount, new vector<DATA_TYPE>(oFMapSize[BATCH] * oFMapSize[CHANNEL] * oFMapSize[HEIGHT] * oFMapSize[WIDTH]));
-    oFMap = make_pair(++vaCount, new vector<DATA_TYPE>(0));
+    // oFMap = make_pair(++sim_context->va_count, new vector<DATA_TYPE>(oFMapSize[BATCH] * oFMapSize[CHANNEL] * oFMapSize[HEIGHT] * oFMapSize[WIDTH]));
+    oFMap = make_pair(++sim_context->va_count, new vector<DATA_TYPE>(0));
 }
 
 
@@ -1078,8 +1126,8 @@ Dense::Dense(int layer_id, vector<int> input_size, int output_width)
 {
     calculateOFMapSize();
     // int size = oFMapSize[BATCH] * oFMapSize[CHANNEL] * oFMapSize[HEIGHT] * oFMapSize[WIDTH];
-    // oFMap = make_pair(++vaCount, new vector<DATA_TYPE>(size));
-    oFMap = make_pair(++vaCount, new vector<DATA_TYPE>(0));
+    // oFMap = make_pair(++sim_context->va_count, new vector<DATA_TYPE>(size));
+    oFMap = make_pair(++sim_context->va_count, new vector<DATA_TYPE>(0));
 }
 
 
@@ -1137,6 +1185,25 @@ Dense::printInfo()
 }
 
 
+/** ===============================================================================================
+ * \name    getBlockResource
+ *
+ * \brief   The block keeps the input vector in the shared memory
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+BlockResource
+Dense::getBlockResource() const
+{
+    BlockResource block = Layer::getBlockResource();
+    block.registers     = 32;
+    block.shared_memory = min((int)(iFMapSize[CHANNEL] * sizeof(DATA_TYPE)), OCCUPANCY_MAX_SHARED_MEMORY);
+
+    return block;
+}
+
+
 /** ===============================================================================================
  * \name    issueLayer
  *
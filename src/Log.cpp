@@ -0,0 +1,263 @@
+/**
+ * \name    Log.cpp
+ *
+ * \brief   Implement the writer of the log file
+ *
+ * \date    Oct 18, 2026
+ */
+
+#include "include/Log.h"
+
+#include <fcntl.h>
+
+/** ===============================================================================================
+ * \name    instance
+ *
+ * \brief   The writer of the simulation context of the calling thread, created at the first use
+ *
+ * \note    The forked process (the profiling simulation) starts with a closed writer
+ *
+ * \endcond
+ * ================================================================================================
+ */
+LogWriter&
+LogWriter::instance ()
+{
+    static pthread_once_t fork_once = PTHREAD_ONCE_INIT;
+    static pthread_mutex_t create_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+    pthread_once(&fork_once, [] () {pthread_atfork(prepareFork, parentFork, childFork);});
+
+    pthread_mutex_lock(&create_mutex);
+    if (!sim_context->log_writer) sim_context->log_writer = new LogWriter();
+    pthread_mutex_unlock(&create_mutex);
+
+    return *sim_context->log_writer;
+}
+
+
+/** ===============================================================================================
+ * \name    LogWriter
+ *
+ * \brief   Create the ring buffer
+ *
+ * \endcond
+ * ================================================================================================
+ */
+LogWriter::LogWriter() : ring(LOG_BUFFER_SIZE)
+{
+    pthread_mutex_init(&mutex, NULL);
+    pthread_cond_init(&data_cond, NULL);
+    pthread_cond_init(&space_cond, NULL);
+}
+
+
+/** ===============================================================================================
+ * \name    open
+ *
+ * \brief   Truncate the log file and start the flush thread
+ *
+ * \param   path    the log file
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+LogWriter::open (const std::string& path)
+{
+    close();
+
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if (fd < 0)
+    {
+        log_E("LogWriter", "Cannot open the log " + path);
+        return;
+    }
+
+    head = tail = 0;
+    closing = false;
+    running = pthread_create(&flusher, NULL, flushThread, this) == 0;
+    ASSERT(running, "Cannot create the flush thread of the log");
+}
+
+
+/** ===============================================================================================
+ * \name    write
+ *
+ * \brief   Copy the text into the ring buffer, wait for the flush thread if the ring is full
+ *
+ * \param   text    the lines to append
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+LogWriter::write (const std::string& text)
+{
+    if (text.empty()) return;
+
+    if (!running)
+    {
+        std::ofstream file(LOG_OUT_PATH + program_name + ".txt", std::ios::app);
+        file << text;
+        file.close();
+        return;
+    }
+
+    pthread_mutex_lock(&mutex);
+    for (size_t offset = 0; offset < text.size();)
+    {
+        while (head - tail == ring.size()) pthread_cond_wait(&space_cond, &mutex);
+
+        size_t position = head % ring.size();
+        size_t length   = std::min({text.size() - offset, (size_t)(ring.size() - (head - tail)), ring.size() - position});
+        memcpy(&ring[position], text.data() + offset, length);
+
+        head   += length;
+        offset += length;
+        pthread_cond_signal(&data_cond);
+    }
+    pthread_mutex_unlock(&mutex);
+}
+
+
+/** ===============================================================================================
+ * \name    flush
+ *
+ * \brief   Wait until the buffered lines are written
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+LogWriter::flush ()
+{
+    if (!running) return;
+
+    pthread_mutex_lock(&mutex);
+    while (tail != head) pthread_cond_wait(&space_cond, &mutex);
+    pthread_mutex_unlock(&mutex);
+}
+
+
+/** ===============================================================================================
+ * \name    close
+ *
+ * \brief   Write the buffered lines and stop the flush thread, the later lines are appended to the
+ *          file directly
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+LogWriter::close ()
+{
+    if (!running) return;
+
+    pthread_mutex_lock(&mutex);
+    closing = true;
+    pthread_cond_signal(&data_cond);
+    pthread_mutex_unlock(&mutex);
+
+    pthread_join(flusher, NULL);
+    ::close(fd);
+
+    fd = -1;
+    running = false;
+}
+
+
+/** ===============================================================================================
+ * \name    flushThread
+ *
+ * \brief   Write the ring buffer into the file until the writer is closed and the ring is empty
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void*
+LogWriter::flushThread (void* arg)
+{
+    LogWriter* writer = (LogWriter*)arg;
+
+    pthread_mutex_lock(&writer->mutex);
+    while (1)
+    {
+        while (writer->head == writer->tail && !writer->closing) pthread_cond_wait(&writer->data_cond, &writer->mutex);
+        if (writer->head == writer->tail) break;
+
+        /* Write the contiguous part of the ring without holding the lock */
+        size_t position = writer->tail % writer->ring.size();
+        size_t length   = std::min((size_t)(writer->head - writer->tail), writer->ring.size() - position);
+        pthread_mutex_unlock(&writer->mutex);
+
+        for (size_t written = 0; written < length;)
+        {
+            ssize_t n = ::write(writer->fd, &writer->ring[position + written], length - written);
+            if (n <= 0) break;
+            written += n;
+        }
+
+        pthread_mutex_lock(&writer->mutex);
+        writer->tail += length;
+        pthread_cond_broadcast(&writer->space_cond);
+    }
+    pthread_mutex_unlock(&writer->mutex);
+
+    return NULL;
+}
+
+
+/** ===============================================================================================
+ * \name    prepareFork / parentFork / childFork
+ *
+ * \brief   Keep the ring consistent across fork, the flush thread is not copied into the child, so
+ *          the child drops the lines of the parent and starts closed
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+LogWriter::prepareFork ()
+{
+    if (sim_context->log_writer) pthread_mutex_lock(&sim_context->log_writer->mutex);
+}
+
+void
+LogWriter::parentFork ()
+{
+    if (sim_context->log_writer) pthread_mutex_unlock(&sim_context->log_writer->mutex);
+}
+
+void
+LogWriter::childFork ()
+{
+    if (!sim_context->log_writer) return;
+
+    LogWriter& writer = *sim_context->log_writer;
+    pthread_mutex_init(&writer.mutex, NULL);
+    pthread_cond_init(&writer.data_cond, NULL);
+    pthread_cond_init(&writer.space_cond, NULL);
+
+    if (writer.running) ::close(writer.fd);
+    writer.fd      = -1;
+    writer.running = false;
+    writer.closing = false;
+    writer.head    = writer.tail = 0;
+}
+
+
+/** ===============================================================================================
+ * \name    log_fatal
+ *
+ * \brief   Write the message of the failed ASSERT and flush the log before exit
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+log_fatal (const std::string& message)
+{
+    LogWriter::instance().write(message);
+    LogWriter::instance().close();
+}
@@ -8,13 +8,6 @@
 
 #include "include/Memory.hpp"
 
-/* ************************************************************************************************
- * Global Variable
- * ************************************************************************************************
- */
-int Memory::memoryCount  = 0;
-unsigned long long Memory::storageCount = PAGE_SIZE;    // the first page in not allow to use
-
 /** ===============================================================================================
  * \name    Memory
  * 
@@ -30,8 +23,8 @@ unsigned long long Memory::storageCount = PAGE_SIZE;    // the first page in not
  * ================================================================================================
  */
 Memory::Memory(Memory_t memory_type, unsigned long long storage_size, int total_bandwidth, int channel_bandwidth) 
-    : memoryIndex(memoryCount++), memoryType(memory_type), recorder(MemoryRecord())
-    , storageSize(storage_size), startPhysicalAddress(storageCount), endPhysicalAddress(storageCount + storage_size)
+    : memoryIndex(sim_context->memory_count++), memoryType(memory_type), recorder(MemoryRecord())
+    , storageSize(storage_size), startPhysicalAddress(sim_context->storage_count), endPhysicalAddress(sim_context->storage_count + storage_size)
     , totalBandwidth(total_bandwidth), channelBandwidth(channel_bandwidth)
 {
     /* Create physical storage */
@@ -46,7 +39,7 @@ Memory::Memory(Memory_t memory_type, unsigned long long storage_size, int total_
 
     access_finish_queue  = {};
 
-    storageCount += storageSize;
+    sim_context->storage_count += storageSize;
 }
 
 
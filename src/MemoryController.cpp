@@ -7,6 +7,16 @@
  */
 
 #include "include/MemoryController.hpp"
+#include "include/Trace.hpp"
+#include "include/Statistics.hpp"
+
+/* ************************************************************************************************
+ * Global Variable
+ * ************************************************************************************************
+ */
+/* Statistic */
+static const Statistics::Counter stat_mc_read_page  = Statistics::instance().counter("mc.read_page", "page");
+static const Statistics::Counter stat_mc_write_page = Statistics::instance().counter("mc.write_page", "page");
 
 /** ===============================================================================================
  * \name    MemoryController
@@ -15,11 +25,12 @@
  * 
  * \param   storage_limit       the phsical storage bound
  * \param   page_size           the size of one page frame
+ * \param   channel_num         the number of GPUs
  * 
  * \endcond
  * ================================================================================================
  */
-MemoryController::MemoryController(unsigned long long storage_limit, int page_size) : storageLimit(storage_limit), pageFrameOffset(log2(page_size))
+MemoryController::MemoryController(unsigned long long storage_limit, int page_size, int channel_num) : storageLimit(storage_limit), pageFrameOffset(log2(page_size)), mChannels(channel_num)
 {
     // if (system_resource.DRAM_SPACE) storages.insert(make_pair(Memory_t::SPACE_DRAM, new DRAM(system_resource.DRAM_SPACE)));
     // if (system_resource.VRAM_SPACE) storages.insert(make_pair(Memory_t::SPACE_VRAM, new VRAM(system_resource.VRAM_SPACE)));
@@ -66,19 +77,24 @@ MemoryController::cycle()
 {
     log_I("MemoryController Cycle", to_string(total_gpu_cycle));
 
-    if (!gmmu_to_mc_queue.empty())
+    for (auto& channel : mChannels)
     {
-        auto access = gmmu_to_mc_queue.front();
+        if (channel.gmmu_to_mc_queue.empty()) continue;
+
+        auto access = channel.gmmu_to_mc_queue.front();
         auto type = access->type;
 
         for (auto page_id : access->pageIDs)
         {
             (type == Read) ? mPages[page_id].record.read_counter++ : mPages[page_id].record.write_counter++;
             mPages[page_id].record.access_count++;
+            mPages[page_id].dirty |= (type == Write);
         }
 
-        gmmu_to_mc_queue.pop_front();
-        mc_to_gmmu_queue.push_back(access);
+        (type == Read) ? stat_mc_read_page.add(access->pageIDs.size()) : stat_mc_write_page.add(access->pageIDs.size());
+
+        channel.gmmu_to_mc_queue.pop_front();
+        channel.mc_to_gmmu_queue.push_back(access);
     }
 }
 
@@ -172,9 +188,12 @@ MemoryController::memoryRelease (Page* page)
     if (page == nullptr) return;
     memoryRelease(page->nextPage);
 
+    if (trace_recorder) trace_recorder->recordEvent(TRACE_RELEASE, {}, {page->pageIndex});
+
     page->record   = {};
     page->nextPage = nullptr;
     page->location = SPACE_DRAM;
+    page->dirty    = false;
 
     auto it = find(usedPageList.begin(), usedPageList.end(), page);
     usedPageList.erase(it);
@@ -0,0 +1,366 @@
+/**
+ * \name    ModelLoader.cpp
+ *
+ * \brief   Implement the model description loader
+ *
+ * \date    Oct 18, 2026
+ */
+
+#include "include/ModelLoader.hpp"
+
+/* ************************************************************************************************
+ * Global Variable
+ * ************************************************************************************************
+ */
+map<string, ModelLoader> ModelLoader::models;
+
+pthread_mutex_t ModelLoader::modelsMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* The available options of each statement */
+static const map<string, vector<string>> LAYER_OPTIONS = {
+    {"Input",    {"shape"}},
+    {"Conv2D",   {"out", "kernel", "stride", "padding", "activation"}},
+    {"Pooling",  {"kernel", "stride", "padding", "activation"}},
+    {"Dense",    {"out"}},
+    {"Flatten",  {}},
+    {"ByPass",   {"channel"}},
+    {"CaseCade", {}},
+    {"CaseCode", {}},
+};
+
+
+/** ===============================================================================================
+ * \name    ModelLoader
+ *
+ * \brief   Parse the model description file
+ *
+ * \param   model_name      the model name
+ * \param   model_path      the path of the description file
+ *
+ * \endcond
+ * ================================================================================================
+ */
+ModelLoader::ModelLoader(const string& model_name, const string& model_path) : name(model_name), path(model_path)
+{
+    ifstream file(path);
+    ASSERT(file.is_open(), "Cannot open the model description " + path + ", try --help");
+
+    /* Split into tokens, the braces are always single tokens */
+    vector<pair<string, int>> tokens;
+    string line, content;
+    for (int line_num = 1; getline(file, line); line_num++)
+    {
+        line = line.substr(0, line.find('#'));
+        content += line + "\n";
+        for (char brace : {'{', '}'})
+        {
+            for (auto pos = line.find(brace); pos != string::npos; pos = line.find(brace, pos + 3))
+            {
+                line.replace(pos, 1, string(" ") + brace + " ");
+            }
+        }
+
+        stringstream ss(line);
+        string token;
+        while (ss >> token) tokens.emplace_back(token, line_num);
+    }
+    file.close();
+    signature = hash<string>()(content);
+
+    root.type = "CaseCade";
+    root.line = 0;
+
+    size_t index = 0;
+    parseLayers(tokens, index, root);
+    ASSERT(index == tokens.size(), path + ":" + to_string(tokens[index].second) + ": unexpected \"}\"");
+
+    /* The first statement gives the input size */
+    ASSERT(!root.layers.empty() && root.layers.front().type == "Input", path + ": expect \"Input shape=CxHxW\" at the beginning");
+    inputSize = getDims(root.layers.front(), "shape", {});
+    ASSERT(inputSize.size() == 3, path + ":" + to_string(root.layers.front().line) + ": expect \"Input shape=CxHxW\"");
+    inputSize.insert(inputSize.begin(), 1);
+    root.layers.erase(root.layers.begin());
+
+    ASSERT(!root.layers.empty(), path + ": model without layer");
+}
+
+
+/** ===============================================================================================
+ * \name    load
+ *
+ * \brief   Get the description of the model, the file is parsed once at the first load
+ *
+ * \param   model_type      the model name in MODEL_PATH (LeNet | ResNet18 ...) or the path of the
+ *                          description file (path/to/model.net)
+ *
+ * \return  the parsed description
+ *
+ * \endcond
+ * ================================================================================================
+ */
+const ModelLoader&
+ModelLoader::load (const string& model_type)
+{
+    pthread_mutex_lock(&modelsMutex);
+
+    auto it = models.find(model_type);
+    if (it == models.end())
+    {
+        /* The model is named by the file name without extension */
+        bool is_path = model_type.find('/') != string::npos || (model_type.size() > 4 && model_type.substr(model_type.size() - 4) == ".net");
+        string model_path = is_path ? model_type : MODEL_PATH + model_type + ".net";
+        string model_name = model_path.substr(model_path.find_last_of('/') + 1);
+        model_name = model_name.substr(0, model_name.find_last_of('.'));
+
+        it = models.find(model_name);
+        if (it != models.end())
+        {
+            ASSERT(it->second.path == model_path, "Model name " + model_name + " is used by both " + it->second.path + " and " + model_path);
+        }
+        else it = models.insert({model_name, ModelLoader(model_name, model_path)}).first;
+    }
+
+    pthread_mutex_unlock(&modelsMutex);
+    return it->second;
+}
+
+
+/** ===============================================================================================
+ * \name    buildLayerGraph
+ *
+ * \brief   Build the described layers into the graph
+ *
+ * \param   graph           the sequential layer group of the model
+ * \param   layer_id        the next layer index, increased by the number of built layers
+ * \param   input_size      [batch, channel, height, width]
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+ModelLoader::buildLayerGraph (LayerGroup* graph, int& layer_id, vector<int> input_size) const
+{
+    addLayers(graph, root, layer_id, input_size);
+}
+
+
+/** ===============================================================================================
+ * \name    parseLayers
+ *
+ * \brief   Parse the statements until the end of file or the "}" of the group
+ *
+ * \param   tokens      the (token, line number) of the file
+ * \param   index       the current token, stops at the closing "}"
+ * \param   group       the group to keep the parsed statements
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+ModelLoader::parseLayers (const vector<pair<string, int>>& tokens, size_t& index, LayerDesc& group)
+{
+    while (index < tokens.size() && tokens[index].first != "}")
+    {
+        LayerDesc desc;
+        desc.type = tokens[index].first;
+        desc.line = tokens[index++].second;
+
+        string where = path + ":" + to_string(desc.line) + ": ";
+        ASSERT(LAYER_OPTIONS.count(desc.type), where + "unknown layer type " + desc.type);
+
+        /* Options */
+        auto& available = LAYER_OPTIONS.at(desc.type);
+        for (; index < tokens.size() && tokens[index].first.find('=') != string::npos; index++)
+        {
+            string option = tokens[index].first;
+            string key    = option.substr(0, option.find('='));
+            string value  = option.substr(option.find('=') + 1);
+
+            ASSERT(find(available.begin(), available.end(), key) != available.end(), where + "unknown option " + key + " of " + desc.type);
+            ASSERT(!value.empty(), where + "empty option " + key);
+            desc.options[key] = value;
+        }
+
+        /* Member layers */
+        if (desc.type == "CaseCade" || desc.type == "CaseCode")
+        {
+            ASSERT(index < tokens.size() && tokens[index].first == "{", where + "expect \"{\" after " + desc.type);
+            parseLayers(tokens, ++index, desc);
+            ASSERT(index < tokens.size(), where + "missing \"}\" of " + desc.type);
+            ASSERT(!desc.layers.empty(), where + "empty " + desc.type);
+            index++;
+        }
+        group.layers.emplace_back(move(desc));
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    addLayers
+ *
+ * \brief   Build the member layers of the description into the group
+ *
+ * \param   group           the layer group
+ * \param   desc            the description of the group
+ * \param   layer_id        the next layer index
+ * \param   input_size      the input size of the group
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+ModelLoader::addLayers (LayerGroup* group, const LayerDesc& desc, int& layer_id, vector<int> input_size) const
+{
+    for (auto& layer : desc.layers)
+    {
+        /* The sequential layer takes the output of the previous one, the branches share the input */
+        bool sequential = group->groupType == Group_t::CaseCade && !group->layers.empty();
+        group->addLayer(buildLayer(layer, layer_id, sequential ? group->getOFMapSize() : input_size));
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    buildLayer
+ *
+ * \brief   Build a layer or a layer group
+ *
+ * \param   desc            the description of the layer
+ * \param   layer_id        the next layer index
+ * \param   input_size      [batch, channel, height, width]
+ *
+ * \return  the built layer
+ *
+ * \endcond
+ * ================================================================================================
+ */
+Layer*
+ModelLoader::buildLayer (const LayerDesc& desc, int& layer_id, vector<int> input_size) const
+{
+    string where = path + ":" + to_string(desc.line) + ": ";
+
+    if (desc.type == "CaseCade" || desc.type == "CaseCode")
+    {
+        LayerGroup* group = new LayerGroup(desc.type == "CaseCade" ? Group_t::CaseCade : Group_t::CaseCode);
+        addLayers(group, desc, layer_id, input_size);
+        return group;
+    }
+    else if (desc.type == "Conv2D")
+    {
+        vector<int> kernel = getDims(desc, "kernel", {});
+        ASSERT(kernel.size() == 2, where + "expect kernel=HxW");
+
+        int out = getInt(desc, "out", 0);
+        ASSERT(out > 0, where + "expect out=channel");
+
+        return new Conv2D(layer_id++, input_size, {out, input_size[CHANNEL], kernel[0], kernel[1]}, getName(desc, "activation")
+                        , getDims(desc, "stride", {1, 1}), getDims(desc, "padding", {0, 0}));
+    }
+    else if (desc.type == "Pooling")
+    {
+        vector<int> kernel = (desc.options.count("kernel") && desc.options.at("kernel") == "global")
+                           ? vector<int>{input_size[HEIGHT], input_size[WIDTH]} : getDims(desc, "kernel", {});
+        ASSERT(kernel.size() == 2, where + "expect kernel=HxW");
+
+        return new Pooling(layer_id++, input_size, kernel, getName(desc, "activation"), getDims(desc, "stride", {1, 1}), getDims(desc, "padding", {0, 0}));
+    }
+    else if (desc.type == "Dense")
+    {
+        int out = getInt(desc, "out", 0);
+        ASSERT(out > 0, where + "expect out=width");
+
+        return new Dense(layer_id++, input_size, out);
+    }
+    else if (desc.type == "Flatten")
+    {
+        return new Flatten(layer_id++, input_size);
+    }
+    else if (desc.type == "ByPass")
+    {
+        if (!desc.options.count("channel")) return new ByPass(layer_id++, input_size);
+
+        return new ByPass(layer_id++, input_size, {input_size[BATCH], getInt(desc, "channel", 0), input_size[HEIGHT], input_size[WIDTH]});
+    }
+
+    ASSERT(false, where + desc.type + " is only allowed at the beginning");
+    return nullptr;
+}
+
+
+/** ===============================================================================================
+ * \name    getInt
+ *
+ * \brief   Get the integer option
+ *
+ * \endcond
+ * ================================================================================================
+ */
+int
+ModelLoader::getInt (const LayerDesc& desc, const string& key, int default_value) const
+{
+    if (!desc.options.count(key)) return default_value;
+
+    try {
+        size_t end;
+        int value = stoi(desc.options.at(key), &end);
+        if (end == desc.options.at(key).size()) return value;
+    } catch(exception& e) {}
+
+    ASSERT(false, path + ":" + to_string(desc.line) + ": expect integer " + key + "=" + desc.options.at(key));
+    return default_value;
+}
+
+
+/** ===============================================================================================
+ * \name    getDims
+ *
+ * \brief   Get the dimension option "AxB...", the single value "A" is expanded to "AxA"
+ *
+ * \endcond
+ * ================================================================================================
+ */
+vector<int>
+ModelLoader::getDims (const LayerDesc& desc, const string& key, vector<int> default_value) const
+{
+    if (!desc.options.count(key)) return default_value;
+
+    vector<int> dims;
+    stringstream ss(desc.options.at(key));
+    string dim;
+    while (getline(ss, dim, 'x'))
+    {
+        size_t end = 0;
+        try {
+            dims.emplace_back(stoi(dim, &end));
+        } catch(exception& e) {}
+
+        ASSERT(end != 0 && end == dim.size() && dims.back() >= 0, path + ":" + to_string(desc.line) + ": expect dimension " + key + "=AxB");
+    }
+    if (dims.size() == 1) dims.emplace_back(dims.front());
+
+    return dims;
+}
+
+
+/** ===============================================================================================
+ * \name    getName
+ *
+ * \brief   Get the name option, the layer keeps the char* so the names are kept in a pool
+ *
+ * \endcond
+ * ================================================================================================
+ */
+char*
+ModelLoader::getName (const LayerDesc& desc, const string& key) const
+{
+    static set<string> pool;
+    static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+    if (!desc.options.count(key)) return (char*)"None";
+
+    pthread_mutex_lock(&pool_mutex);
+    char* name = (char*)pool.insert(desc.options.at(key)).first->c_str();
+    pthread_mutex_unlock(&pool_mutex);
+
+    return name;
+}
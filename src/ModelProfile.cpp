@@ -0,0 +1,305 @@
+/**
+ * \name    ModelProfile.cpp
+ *
+ * \brief   Implement the model profiler, the model information is derived from the layer graph and
+ *          the execute time is measured by an isolated simulation. The profiles are cached in
+ *          PROFILE_PATH by model, input size and hardware profile.
+ *
+ * \date    Oct 18, 2026
+ */
+
+#include "include/GPGPU.hpp"
+
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+/** ===============================================================================================
+ * \name    getModelInfo
+ *
+ * \brief   Return the model information from the profile cache, the missing profile is derived
+ *          and saved. The execute time is profiled only with --profile or HARD_DEADLINE.
+ *
+ * \param   model_type      the model name or the model description file
+ *
+ * \return  Model::ModelInfo
+ *
+ * \note    The profiling simulation forks the process, profile the models before constructing the
+ *          GPGPU (see main)
+ *
+ * \endcond
+ * ================================================================================================
+ */
+Model::ModelInfo
+Model::getModelInfo(const char* model_type)
+{
+    auto& model = ModelLoader::load(model_type);
+    bool need_execute_time = command.PROFILE_EXECUTE_TIME || HARD_DEADLINE;
+
+    pthread_mutex_lock(&infoMutex);
+    auto it = modelInfos.find(model.name);
+    if (it != modelInfos.end() && (!need_execute_time || it->second.totalExecuteTime))
+    {
+        ModelInfo info = it->second;
+        pthread_mutex_unlock(&infoMutex);
+        return info;
+    }
+
+    string profile_path = PROFILE_PATH + model.name + "_" + to_string(model.inputSize[CHANNEL]) + "x" + to_string(model.inputSize[HEIGHT])
+                        + "x" + to_string(model.inputSize[WIDTH]) + "_" + hardware_config.name + ".profile";
+
+    ModelInfo info(model.name.c_str());
+    if (!loadModelInfo(profile_path, model.signature, info))
+    {
+        info = deriveModelInfo(model);
+        saveModelInfo(profile_path, model.signature, info);
+    }
+    modelInfos[model.name] = info;
+    pthread_mutex_unlock(&infoMutex);
+
+    /* The child of the profiling simulation looks up the profiles, so it is forked without the lock */
+    if (need_execute_time && !info.totalExecuteTime)
+    {
+        measureModelInfo(model, profile_path);
+
+        bool measured = loadModelInfo(profile_path, model.signature, info) && info.totalExecuteTime;
+        ASSERT(measured, "Fail to profile " + model.name + ", see the Profile_" + model.name + " log");
+
+        pthread_mutex_lock(&infoMutex);
+        modelInfos[model.name] = info;
+        pthread_mutex_unlock(&infoMutex);
+    }
+
+    return info;
+}
+
+
+/** ===============================================================================================
+ * \name    deriveModelInfo
+ *
+ * \brief   Derive the model information from the layer graph, the execute time and the requests
+ *          are left to the profiling simulation
+ *
+ * \param   model       the model description
+ *
+ * \return  Model::ModelInfo
+ *
+ * \endcond
+ * ================================================================================================
+ */
+Model::ModelInfo
+Model::deriveModelInfo(const ModelLoader& model)
+{
+    ModelInfo info(model.name.c_str());
+
+    LayerGroup graph;
+    int layer_id = 0;
+    model.buildLayerGraph(&graph, layer_id, model.inputSize);
+
+    /* Each layer out of the layer groups is compiled into one kernel */
+    vector<Layer*> layers;
+    list<LayerGroup*> groups = {&graph};
+    while (!groups.empty())
+    {
+        for (auto layer : groups.front()->layers)
+        {
+            LayerGroup* group = dynamic_cast<LayerGroup*>(layer);
+            group ? groups.emplace_back(group) : layers.emplace_back(layer);
+        }
+        groups.pop_front();
+    }
+
+    /* The feature maps are shared by the connected layers, count once by the virtual address */
+    map<int, unsigned long long> io_va_list, filter_va_list;
+    for (auto layer : layers)
+    {
+        if (layer->getIFMap().second)  io_va_list.emplace(layer->getIFMap().first, layer->getIFMapMemory());
+        if (layer->getOFMap().second)  io_va_list.emplace(layer->getOFMap().first, layer->getOFMapMemory());
+        if (layer->getFilter().second) filter_va_list.emplace(layer->getFilter().first, layer->getFilterMemory());
+    }
+
+    for (auto& va : io_va_list)     info.ioMemCount     += va.second;
+    for (auto& va : filter_va_list) info.filterMemCount += va.second;
+
+    vector<int> output_size = graph.getOFMapSize();
+    info.numOfLayers = layers.size();
+    info.inputSize   = {model.inputSize[CHANNEL], model.inputSize[HEIGHT], model.inputSize[WIDTH]};
+    info.outputSize  = {output_size[CHANNEL], output_size[HEIGHT], output_size[WIDTH]};
+
+    return info;
+}
+
+
+/** ===============================================================================================
+ * \name    measureModelInfo
+ *
+ * \brief   Run the model alone on the whole GPU without memory oversubscription in a child process,
+ *          the measured requests and execute time are saved into the profile
+ *
+ * \param   model           the model description
+ * \param   profile_path    the profile to update
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+Model::measureModelInfo(const ModelLoader& model, const string& profile_path)
+{
+    log_W("Profiling", model.name + " ...");
+    std::cout.flush();
+
+    pid_t pid = fork();
+    ASSERT(pid >= 0, "Cannot fork the profiling simulation of " + model.name);
+
+    if (pid == 0)
+    {
+        ASSERT(freopen("/dev/null", "w", stdout) != NULL, "Cannot silence the profiling simulation");
+
+        command.TASK_LIST             = {make_pair(model.name, make_tuple(1, 0.0f, -1.0f, -1.0f))};
+        command.SCHEDULER_MODE        = SCHEDULER::Baseline;
+        command.PREFETCH_NEXT_KERNEL  = false;
+        command.ACCESS_COUNTER_THRESHOLD = 0;
+        command.FIDELITY_MODE         = FIDELITY::CYCLE;
+        command.MEMO_MODE             = MEMOIZATION::NO_MEMO;
+        command.TRACE_RECORD_PATH     = "";
+        command.TRACE_REPLAY_PATH     = "";
+        command.TIMELINE_PATH         = "";
+        command.STATS_PATH            = "";
+        command.GPU_NUM               = 1;
+        command.PEER_LINK             = false;
+        command.WARP_SCHEDULER_MODE   = WARP_SCHEDULER::UNLIMITED_ISSUE;
+        command.OCCUPANCY             = false;
+        command.DISPATCH_MODE         = DISPATCH::STATIC_DISPATCH;
+        command.HW_QUEUE_NUM          = 0;
+        command.STREAM_PRIORITY.clear();
+        system_resource.SM_NUM        = hardware_config.sm_num;
+        system_resource.VRAM_SPACE    = -1;
+        program_name = "Profile_" + model.name;
+
+        /* Placeholder execute time, so the child does not profile again */
+        ModelInfo& placeholder = modelInfos.at(model.name);
+        placeholder.totalExecuteTime = 1;
+        placeholder.layerExecuteTime = vector<unsigned long long>(placeholder.numOfLayers, 0);
+
+        {
+            GPGPU gpgpu;
+            gpgpu.run();
+        }
+
+        ASSERT(measuredInfos.count(model.name), "Model " + model.name + " not finished in the profiling simulation");
+
+        ModelInfo info     = modelInfos.at(model.name);
+        ModelInfo measured = measuredInfos.at(model.name);
+        info.numOfRequest     = measured.numOfRequest;
+        info.numOfCycle       = measured.numOfCycle;
+        info.numOfRead        = measured.numOfRead;
+        info.numOfWrite       = measured.numOfWrite;
+        info.totalExecuteTime = measured.totalExecuteTime;
+        info.layerExecuteTime = measured.layerExecuteTime;
+
+        saveModelInfo(profile_path, model.signature, info);
+        _exit(0);
+    }
+
+    int status;
+    waitpid(pid, &status, 0);
+    ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0, "The profiling simulation of " + model.name + " failed");
+}
+
+
+/** ===============================================================================================
+ * \name    loadModelInfo
+ *
+ * \brief   Load the cached profile
+ *
+ * \param   profile_path    the profile file
+ * \param   signature       the signature of the model description
+ * \param   info            the loaded model information
+ *
+ * \return  false if the profile is missing or outdated
+ *
+ * \endcond
+ * ================================================================================================
+ */
+bool
+Model::loadModelInfo(const string& profile_path, size_t signature, ModelInfo& info)
+{
+    ifstream file(profile_path);
+    if (!file.is_open()) return false;
+
+    map<string, vector<unsigned long long>> values;
+    string line;
+    while (getline(file, line))
+    {
+        line = line.substr(0, line.find('#'));
+        auto pos = line.find('=');
+        if (pos == string::npos) continue;
+
+        stringstream key_ss(line.substr(0, pos)), value_ss(line.substr(pos + 1));
+        string key;
+        unsigned long long value;
+        key_ss >> key;
+        while (value_ss >> value) values[key].emplace_back(value);
+    }
+    file.close();
+
+    auto get = [&values](const string& key) {return values[key].empty() ? 0 : values[key].front();};
+    if (get("signature") != signature) return false;
+
+    info.numOfLayers      = get("numOfLayers");
+    info.numOfRequest     = get("numOfRequest");
+    info.numOfCycle       = get("numOfCycle");
+    info.ioMemCount       = get("ioMemCount");
+    info.filterMemCount   = get("filterMemCount");
+    info.numOfRead        = get("numOfRead");
+    info.numOfWrite       = get("numOfWrite");
+    info.inputSize        = vector<int>(values["inputSize"].begin(), values["inputSize"].end());
+    info.outputSize       = vector<int>(values["outputSize"].begin(), values["outputSize"].end());
+    info.totalExecuteTime = get("totalExecuteTime");
+    info.layerExecuteTime = values["layerExecuteTime"];
+
+    return info.numOfLayers > 0 && (info.layerExecuteTime.empty() || info.layerExecuteTime.size() == info.numOfLayers);
+}
+
+
+/** ===============================================================================================
+ * \name    saveModelInfo
+ *
+ * \brief   Save the profile
+ *
+ * \param   profile_path    the profile file
+ * \param   signature       the signature of the model description
+ * \param   info            the model information
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+Model::saveModelInfo(const string& profile_path, size_t signature, const ModelInfo& info)
+{
+    mkdir(PROFILE_PATH, 0755);
+
+    ofstream file(profile_path, std::ofstream::out | std::ofstream::trunc);
+    if (!file.is_open())
+    {
+        log_W("saveModelInfo", "Cannot write the profile " + profile_path);
+        return;
+    }
+
+    auto join = [](const auto& list) {string buff; for (auto value : list) buff += " " + to_string(value); return buff;};
+
+    file << "# Profile of " << info.modelName << " on " << hardware_config.name << ", regenerated when the model description changes" << std::endl;
+    file << "signature           = " << signature             << std::endl;
+    file << "numOfLayers         = " << info.numOfLayers      << std::endl;
+    file << "numOfRequest        = " << info.numOfRequest     << std::endl;
+    file << "numOfCycle          = " << info.numOfCycle       << std::endl;
+    file << "ioMemCount          = " << info.ioMemCount       << std::endl;    // unit (Byte)
+    file << "filterMemCount      = " << info.filterMemCount   << std::endl;    // unit (Byte)
+    file << "numOfRead           = " << info.numOfRead        << std::endl;
+    file << "numOfWrite          = " << info.numOfWrite       << std::endl;
+    file << "inputSize           =" << join(info.inputSize)   << std::endl;
+    file << "outputSize          =" << join(info.outputSize)  << std::endl;
+    file << "# unit (cycle), 0 if not profiled" << std::endl;
+    file << "totalExecuteTime    = " << info.totalExecuteTime << std::endl;
+    file << "layerExecuteTime    =" << join(info.layerExecuteTime) << std::endl;
+    file.close();
+}
@@ -0,0 +1,175 @@
+/**
+ * \name    NodeScheduler.cpp
+ *
+ * \brief   Implement the node scheduler
+ *
+ * \date    Oct 18, 2026
+ */
+
+#include "include/NodeScheduler.hpp"
+#include "include/ModelLoader.hpp"
+
+/** ===============================================================================================
+ * \name    NodeScheduler
+ *
+ * \brief   Create the applications of command.TASK_LIST and place them
+ *
+ * \param   gpu_num     the number of GPUs in the node
+ *
+ * \endcond
+ * ================================================================================================
+ */
+NodeScheduler::NodeScheduler(int gpu_num) : mPlacement(gpu_num)
+{
+    ASSERT(gpu_num > 0, "The node has no GPU");
+
+    /* *******************************************************************
+     * Create applications
+     * *******************************************************************
+     */
+    for (auto& task : command.TASK_LIST)
+    {
+        auto& model = ModelLoader::load(task.first);
+        mAPPs.push_back(new Application ((char*)model.name.c_str()
+            , model.inputSize
+            , get<0>(task.second)                   // batch size
+            , get<1>(task.second) * GPU_F / 1000    // arrival time
+            , get<2>(task.second) * GPU_F / 1000    // period
+            // , get<3>(task.second) * GPU_F / 1000    //dead;ome
+            , GPU_F * SIMULATION_TIME / 1000
+        ));
+    }
+
+    Placement();
+}
+
+
+/** ===============================================================================================
+ * \name    Placement
+ *
+ * \brief   Place the applications on the GPUs
+ *
+ * \note    * ROUND_ROBIN places the applications in the order of the task set.
+ *
+ * \note    * LEAST_LOAD and LEAST_MEMORY place the application with the largest load (memory) first
+ *          on the GPU with the least placed load (memory), the longest processing time first rule.
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+NodeScheduler::Placement ()
+{
+    if (command.PLACEMENT_MODE == ROUND_ROBIN)
+    {
+        for (size_t i = 0; i < mAPPs.size(); i++) mPlacement[i % mPlacement.size()].push_back(mAPPs[i]);
+        return;
+    }
+
+    /* first: weight, second: application */
+    vector<pair<unsigned long long, Application*>> weights;
+    for (auto app : mAPPs)
+    {
+        weights.emplace_back(make_pair(command.PLACEMENT_MODE == LEAST_LOAD ? getLoad(app) : getMemory(app), app));
+    }
+    stable_sort(weights.begin(), weights.end(), [](const auto& a, const auto& b){return a.first > b.first;});
+
+    vector<unsigned long long> placed_weight(mPlacement.size(), 0);
+    for (auto& weight_pair : weights)
+    {
+        int gpu_id = min_element(placed_weight.begin(), placed_weight.end()) - placed_weight.begin();
+        placed_weight[gpu_id] += weight_pair.first;
+        mPlacement[gpu_id].push_back(weight_pair.second);
+    }
+
+    /* Each GPU schedules its applications in the order of the task set */
+    for (auto& apps : mPlacement)
+    {
+        sort(apps.begin(), apps.end(), [](Application* a, Application* b){return a->appID < b->appID;});
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    getLoad
+ *
+ * \brief   The GPU cycles demanded by the application in the simulation, the arrivals times the
+ *          batch size times the execute time of the model profile (or the compute cycles of the
+ *          model if not profiled)
+ *
+ * \param   app     the application
+ *
+ * \endcond
+ * ================================================================================================
+ */
+unsigned long long
+NodeScheduler::getLoad (Application* app)
+{
+    if (app->arrivalTime >= app->endTime) return 0;
+
+    unsigned long long arrivals = (app->period == 0 || app->period >= app->endTime) ? 1
+                                : (app->endTime - app->arrivalTime - 1) / app->period + 1;
+    unsigned long long execute_time = app->modelInfo.totalExecuteTime ? app->modelInfo.totalExecuteTime : app->modelInfo.numOfCycle;
+
+    return arrivals * app->batchSize * execute_time;
+}
+
+
+/** ===============================================================================================
+ * \name    getMemory
+ *
+ * \brief   The memory footprint of the application, the filters are shared by the batch
+ *
+ * \param   app     the application
+ *
+ * \endcond
+ * ================================================================================================
+ */
+unsigned long long
+NodeScheduler::getMemory (Application* app)
+{
+    return app->modelInfo.filterMemCount + app->modelInfo.ioMemCount * app->batchSize;
+}
+
+
+/** ===============================================================================================
+ * \name    printPlacement
+ *
+ * \brief   Print the applications, the load and the memory placed on each GPU
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+NodeScheduler::printPlacement ()
+{
+    stringstream buff;
+    buff << std::left << std::setw(10) << "GPU"
+         << std::left << std::setw(16) << "Load"
+         << std::left << std::setw(16) << "Memory"
+         << "Applications"
+         << std::endl;
+
+    for (size_t gpu_id = 0; gpu_id < mPlacement.size(); gpu_id++)
+    {
+        unsigned long long load = 0, memory = 0;
+        string apps = "";
+        for (auto app : mPlacement[gpu_id])
+        {
+            load   += getLoad(app);
+            memory += getMemory(app);
+            apps   += to_string(app->appID) + ":" + to_string(app->batchSize) + app->modelType + " ";
+        }
+
+        buff << std::left << std::setw(10) << gpu_id
+             << std::left << std::setw(16) << load
+             << std::left << std::setw(16) << memory
+             << apps
+             << std::endl;
+    }
+
+    std::cout << buff.str();
+    LogStream file;
+        file << buff.str();
+    file.close();
+}
@@ -7,31 +7,44 @@
  */
 
 #include "include/SM.hpp"
+#include "include/Statistics.hpp"
 
 /* ************************************************************************************************
  * Global Variable
  * ************************************************************************************************
  */
-int SM::SMCount = 0;
-int Block::blockCount = 0;
+
+/* Statistic, summed over the SMs */
+static const Statistics::Counter stat_sm_idle_cycle     = Statistics::instance().counter("sm.idle_cycle", "cycle");
+static const Statistics::Counter stat_sm_busy_cycle     = Statistics::instance().counter("sm.busy_cycle", "cycle");
+static const Statistics::Counter stat_warp_compute_cycle = Statistics::instance().counter("warp.compute_cycle", "cycle");
+static const Statistics::Counter stat_warp_wait_cycle   = Statistics::instance().counter("warp.wait_cycle", "cycle");
+static const Statistics::Counter stat_warp_issue        = Statistics::instance().counter("warp.issue", "warp");
+static const Statistics::Counter stat_warp_issue_stall  = Statistics::instance().counter("warp.issue_stall", "warp");   // the ready warps not issued
 
 /** ===============================================================================================
  * \name    SM
  * 
  * \brief   The class of the SM
  * 
- * \param   mc      the pointer of memory controller
+ * \param   sm_id   the index of the SM in its GPU
  * 
  * \endcond
  * ================================================================================================
  */
-SM::SM() : smID(SMCount++)
+SM::SM(int sm_id) : smID(sm_id)
 {
     /* Create Warps */
     for (int i = 0; i < GPU_MAX_WARP_PER_SM; i++)
     {
         mWarps.insert(make_pair(i, Warp(i)));
     }
+
+    /* Create Warp Schedulers */
+    if (command.WARP_SCHEDULER_MODE != UNLIMITED_ISSUE)
+    {
+        for (int i = 0; i < GPU_WARP_SCHEDULER_PER_SM; i++) mWarpSchedulers.emplace_back(i);
+    }
 }
 
 
@@ -135,113 +148,279 @@ SM::cycle()
                     else break;
                 }
             }
-            
+        }
+    }
 
-            /* *******************************************************************
-             * Launch the access
-             * *******************************************************************
-             */
-            list<int> busyThreads;
-            for (auto thread_id : warp->busyThreads)
+    /* *******************************************************************
+     * Issue the ready warps, all of them without the warp schedulers
+     * *******************************************************************
+     */
+    if (command.WARP_SCHEDULER_MODE != UNLIMITED_ISSUE) issueWarps();
+    else
+    {
+        unsigned long long issued = 0;
+        for (auto block : runningBlocks)
+        {
+            for (auto warp : block->warps)
             {
-                if (warp->mthreads.at(thread_id).state != Busy) continue;
+                if (!warp->isReady()) continue;
 
-                auto& thread = warp->mthreads.at(thread_id);
-                
-                /* ******************************
-                 * Handle the read addresses
-                 * ******************************
-                 */
-                if (thread.readIndex != thread.request->readPages.size()) 
-                {
-                    thread.access = new MemoryAccess(block->runningKernel->appID, block->runningKernel->modelID, smID, block->blockID, warp->warpID, thread_id, thread.request->requst_id, AccessType::Read);
-                    
-                    for (int i = GPU_MAX_ACCESS_NUMBER; i > 0 && thread.request->readPages.back().second;)
-                    {
-                        auto& page_pair = thread.request->readPages.at(thread.readIndex);
+                executeWarp(block, warp);
+                issued++;
+            }
+        }
+        stat_warp_issue.add(issued);
+    }
 
-                        int count = min(page_pair.second, i);
-                        thread.access->pageIDs.emplace_back(page_pair.first);
+    /* SM statistic */
+    statistic();
+}
 
-                        ((page_pair.second -= count) == 0) && (++thread.readIndex);
-                        i -= count;
-                    }
-                    ASSERT(thread.access->pageIDs.size() <= GPU_MAX_ACCESS_NUMBER, "Read access overflow");
-                }
 
-                /* ******************************
-                 * Executing the request
-                 * ******************************
-                 */
-                else if (thread.request->numOfInstructions-- > 0) {
-                    busyThreads.push_back(thread_id);
-                    continue;
-                }
+/** ===============================================================================================
+ * \name    issueWarps
+ * 
+ * \brief   Issue the ready warps by the warp schedulers, each issues at most GPU_ISSUE_WIDTH
+ *          warps of its own
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+SM::issueWarps()
+{
+    if (runningBlocks.empty()) return;
 
-                /* ******************************
-                 * Handle the write addresses
-                 * ******************************
-                 */
-                else if (thread.writeIndex != thread.request->writePages.size()) 
-                {
-                    thread.access = new MemoryAccess(block->runningKernel->appID, block->runningKernel->modelID, smID, block->blockID, warp->warpID, thread_id, thread.request->requst_id, AccessType::Write);
-                    
-                    for (int i = GPU_MAX_ACCESS_NUMBER; i > 0 && thread.request->writePages.back().second;)
-                    {
-                        auto& page_pair = thread.request->writePages.at(thread.writeIndex);
-
-                        int count = min(page_pair.second, i);
-                        thread.access->pageIDs.emplace_back(page_pair.first);
-
-                        ((page_pair.second -= count) == 0) && (++thread.writeIndex);
-                        i -= count;
-                    }
-                    ASSERT(thread.access->pageIDs.size() <= GPU_MAX_ACCESS_NUMBER, "Write access overflow");
-                } 
-
-                /* ******************************
-                 * Exception
-                 * ******************************
-                 */
-                else ASSERT(false, "Busy thread should not be idle");
-
-                thread.state = Waiting;
-                /* ******************************
-                 * push access to gmmu
-                 * ******************************
-                 */
-                warp->record.launch_access_counter++;
-                warp->record.access_page_counter += thread.access->pageIDs.size();
-
-                warp->warp_to_gmmu_queue.push_back(thread.access);
-                
+    vector<Block*> warp_blocks(GPU_MAX_WARP_PER_SM, nullptr);
+    for (auto block : runningBlocks)
+    {
+        for (auto warp : block->warps) warp_blocks[warp->warpID] = block;
+    }
+
+    vector<vector<Warp*>> scheduler_warps(mWarpSchedulers.size());
+    unsigned long long ready_warps = 0;
+    for (auto& warp : mWarps)
+    {
+        if (!warp.second.isBusy) continue;
+
+        scheduler_warps[warp.first % mWarpSchedulers.size()].push_back(&warp.second);
+        ready_warps += warp.second.isReady();
+    }
+
+    vector<Warp*> issued;
+    for (auto& scheduler : mWarpSchedulers) scheduler.schedule(scheduler_warps[scheduler.schedulerID], issued);
+
+    for (auto warp : issued)
+    {
+        ASSERT(warp_blocks[warp->warpID], "Issue the warp without block");
+        executeWarp(warp_blocks[warp->warpID], warp);
+    }
+
+    stat_warp_issue.add(issued.size());
+    stat_warp_issue_stall.add(ready_warps - issued.size());
+}
+
+
+/** ===============================================================================================
+ * \name    executeWarp
+ * 
+ * \brief   Advance the busy threads of the issued warp by one step, launch the read access,
+ *          execute one instruction or launch the write access
+ * 
+ * \param   block   the block running the warp
+ * \param   warp    the issued warp
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void
+SM::executeWarp(Block* block, Warp* warp)
+{
+    /* *******************************************************************
+     * Launch the access
+     * *******************************************************************
+     */
+    list<int> busyThreads;
+    for (auto thread_id : warp->busyThreads)
+    {
+        if (warp->mthreads.at(thread_id).state != Busy) continue;
+
+        auto& thread = warp->mthreads.at(thread_id);
+        
+        /* ******************************
+         * Handle the read addresses
+         * ******************************
+         */
+        if (thread.readIndex != thread.request->readPages.size()) 
+        {
+            thread.access = new MemoryAccess(block->runningKernel->appID, block->runningKernel->modelID, block->runningKernel->kernelID, smID, block->blockID, warp->warpID, thread_id, thread.request->requst_id, AccessType::Read);
+            
+            for (int i = GPU_MAX_ACCESS_NUMBER; i > 0 && thread.request->readPages.back().second;)
+            {
+                auto& page_pair = thread.request->readPages.at(thread.readIndex);
+
+                int count = min(page_pair.second, i);
+                thread.access->pageIDs.emplace_back(page_pair.first);
+
+                ((page_pair.second -= count) == 0) && (++thread.readIndex);
+                i -= count;
+            }
+            ASSERT(thread.access->pageIDs.size() <= GPU_MAX_ACCESS_NUMBER, "Read access overflow");
+        }
+
+        /* ******************************
+         * Executing the request
+         * ******************************
+         */
+        else if (thread.request->numOfInstructions-- > 0) {
+            busyThreads.push_back(thread_id);
+            continue;
+        }
+
+        /* ******************************
+         * Handle the write addresses
+         * ******************************
+         */
+        else if (thread.writeIndex != thread.request->writePages.size()) 
+        {
+            thread.access = new MemoryAccess(block->runningKernel->appID, block->runningKernel->modelID, block->runningKernel->kernelID, smID, block->blockID, warp->warpID, thread_id, thread.request->requst_id, AccessType::Write);
+            
+            for (int i = GPU_MAX_ACCESS_NUMBER; i > 0 && thread.request->writePages.back().second;)
+            {
+                auto& page_pair = thread.request->writePages.at(thread.writeIndex);
+
+                int count = min(page_pair.second, i);
+                thread.access->pageIDs.emplace_back(page_pair.first);
+
+                ((page_pair.second -= count) == 0) && (++thread.writeIndex);
+                i -= count;
+            }
+            ASSERT(thread.access->pageIDs.size() <= GPU_MAX_ACCESS_NUMBER, "Write access overflow");
+        } 
+
+        /* ******************************
+         * Exception
+         * ******************************
+         */
+        else ASSERT(false, "Busy thread should not be idle");
+
+        thread.state = Waiting;
+        /* ******************************
+         * push access to gmmu
+         * ******************************
+         */
+        warp->record.launch_access_counter++;
+        warp->record.access_page_counter += thread.access->pageIDs.size();
+
+        warp->warp_to_gmmu_queue.push_back(thread.access);
+        
 #if (PRINT_ACCESS_PATTERN)
-                std::cout << "New access page: ";
-                for (auto page_id : thread.access->pageIDs)
-                {
-                    std::cout << page_id << ", ";
-                }
-                std::cout << std::endl;
+        std::cout << "New access page: ";
+        for (auto page_id : thread.access->pageIDs)
+        {
+            std::cout << page_id << ", ";
+        }
+        std::cout << std::endl;
 #endif
-            }
-            warp->busyThreads = busyThreads;
+    }
+    warp->busyThreads = busyThreads;
 #if (LOG_LEVEL >= VERBOSE)
-            log_V("Warp ID", to_string(warp->warpID));
-            log_V("Total Access", to_string(warp->record.launch_access_counter));
-            log_V("Total Access Pages", to_string(warp->record.access_page_counter));
+    log_V("Warp ID", to_string(warp->warpID));
+    log_V("Total Access", to_string(warp->record.launch_access_counter));
+    log_V("Total Access Pages", to_string(warp->record.access_page_counter));
 #endif
-        }
-    }
+}
 
-    /* SM statistic */
-    statistic();
+
+/** ===============================================================================================
+ * \name    admitBlocks
+ * 
+ * \brief   The number of blocks of the kernel the SM admits by its remaining resource. Without
+ *          --occupancy only the idle SM admits the blocks.
+ * 
+ * \param   kernel  the kernel going to bind
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+int
+SM::admitBlocks(Kernel* kernel)
+{
+    if (!command.OCCUPANCY && !isIdel()) return 0;
+
+    return fitBlocks(resource, getBlockResource(kernel));
+}
+
+
+/** ===============================================================================================
+ * \name    idleBlocks
+ * 
+ * \brief   The number of blocks of the kernel the idle SM admits
+ * 
+ * \param   kernel  the kernel going to bind
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+int
+SM::idleBlocks(Kernel* kernel)
+{
+    return fitBlocks(SM_Resource(), getBlockResource(kernel));
+}
+
+
+/** ===============================================================================================
+ * \name    fitBlocks
+ * 
+ * \brief   The number of blocks fitting in the remaining resource
+ * 
+ * \param   remaining   the remaining resource of the SM
+ * \param   block       the resource of a block
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+int
+SM::fitBlocks(const SM_Resource& remaining, const BlockResource& block)
+{
+    int num_of_warp = ceil((double)block.threads / GPU_MAX_THREAD_PER_WARP);
+
+    int num_of_block = min({remaining.remaining_blocks, remaining.remaining_warps / num_of_warp, remaining.remaining_threads / block.threads});
+    if (block.registers)     num_of_block = min(num_of_block, remaining.remaining_regs / (block.registers * num_of_warp * GPU_MAX_THREAD_PER_WARP));
+    if (block.shared_memory) num_of_block = min(num_of_block, remaining.remaining_shmem / block.shared_memory);
+
+    return max(num_of_block, 0);
+}
+
+
+/** ===============================================================================================
+ * \name    getBlockResource
+ * 
+ * \brief   The resource of the blocks of the kernel, the block has GPU_MAX_WARP_PER_BLOCK warps
+ *          without --occupancy
+ * 
+ * \param   kernel  the kernel going to bind
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+BlockResource
+SM::getBlockResource(Kernel* kernel)
+{
+    if (command.OCCUPANCY) return kernel->getBlockResource();
+
+    return {GPU_MAX_WARP_PER_BLOCK * GPU_MAX_THREAD_PER_WARP, 0, 0};
 }
 
 
 /** ===============================================================================================
  * \name    bindKernel
  * 
- * \brief   Try to bind kernel into SM according to the resource bound.
+ * \brief   Bind the blocks of the kernel into SM, each block takes the resource of the kernel
+ * 
+ * \param   kernel          the kernel going to bind
+ * \param   num_of_request  the requests of each block
+ * \param   num_of_block    the blocks admitted by admitBlocks
  * 
  * \return  return True if bind success
  * 
@@ -249,20 +428,23 @@ SM::cycle()
  * ================================================================================================
  */
 bool
-SM::bindKernel(Kernel* kernel, int num_of_request)
+SM::bindKernel(Kernel* kernel, int num_of_request, int num_of_block)
 {
-    if (resource.remaining_blocks == 0 || resource.remaining_warps == 0) return false;
+    if (num_of_block == 0) return false;
+    ASSERT(num_of_block <= admitBlocks(kernel), "SM " + to_string(smID) + " cannot admit the blocks of kernel " + to_string(kernel->kernelID));
 
-    /* Baseline: each kernel get all resource of SM */
-    int launch_block_num = ceil(resource.remaining_warps / GPU_MAX_WARP_PER_BLOCK);
-    for (int i = 0; i < launch_block_num; i++)
+    BlockResource block_resource = getBlockResource(kernel);
+    int num_of_warp = ceil((double)block_resource.threads / GPU_MAX_THREAD_PER_WARP);
+
+    for (int i = 0; i < num_of_block; i++)
     {
         Block* b = new Block(kernel);
+        b->resource = block_resource;
         b->record.sm_id = smID;
         b->record.block_id = b->blockID;
         b->record.start_cycle = total_gpu_cycle;
 
-        /* Greedy bind all available warp to current block */
+        /* Greedy bind the available warps to current block */
         for (auto& warp : mWarps)
         {
             if(warp.second.isIdle)
@@ -278,7 +460,7 @@ SM::bindKernel(Kernel* kernel, int num_of_request)
 
                 resource.remaining_warps--;
             }
-            if (b->warps.size() == GPU_MAX_WARP_PER_BLOCK) break;
+            if (b->warps.size() == num_of_warp) break;
         }
 
         for (int i = 0; i < num_of_request; i++)
@@ -288,10 +470,14 @@ SM::bindKernel(Kernel* kernel, int num_of_request)
         
         
 #if (PRINT_SM_ALLCOATION_RESULT)
-        std::cout << "Launch kernel:" << kernel->kernelID << " to SM: " << smID << " with warps: " << b->warps.size() << std::endl;
+        std::cout << "Launch kernel:" << kernel->kernelID << " to SM: " << smID << " with warps: " << b->warps.size()
+                  << ", registers: " << block_resource.registers << ", shared memory: " << block_resource.shared_memory << std::endl;
 #endif
         runningBlocks.emplace_back(move(b));
         resource.remaining_blocks--;
+        resource.remaining_threads -= block_resource.threads;
+        resource.remaining_regs    -= block_resource.registers * b->warps.size() * GPU_MAX_THREAD_PER_WARP;
+        resource.remaining_shmem   -= block_resource.shared_memory;
     }
     return true;
 }
@@ -313,27 +499,33 @@ SM::bindKernel(Kernel* kernel, int num_of_request)
 bool
 SM::terminateKernel(Kernel* kernel)
 {
-    for (auto block : runningBlocks)
+    for (auto block = runningBlocks.begin(); block != runningBlocks.end();)
     {
-        if (block->runningKernel == kernel)
+        if ((*block)->runningKernel != kernel)
         {
-            for (auto warp : block->warps)
-            {
-                warp->record = {};
-                for (auto thread : warp->mthreads)
-                {
-                    delete thread.request;
-                    delete thread.access;
-                }
-                warp->gmmu_to_warp_queue.clear();
-                warp->isBusy = false;
-                warp->isIdle = true;
+            block++;
+            continue;
+        }
 
+        for (auto warp : (*block)->warps)
+        {
+            warp->record = {};
+            for (auto thread : warp->mthreads)
+            {
+                delete thread.request;
+                delete thread.access;
             }
-            std::cout << "Release kernel:" << kernel->kernelID << " to SM: " << smID << " with warps: " << block->warps.size() << std::endl;
+            warp->gmmu_to_warp_queue.clear();
+            warp->isBusy = false;
+            warp->isIdle = true;
+
         }
+        std::cout << "Release kernel:" << kernel->kernelID << " to SM: " << smID << " with warps: " << (*block)->warps.size() << std::endl;
+        recycleResource(*block);
+
+        delete *block;
+        runningBlocks.erase(block++);
     }
-    runningBlocks.remove_if([kernel](Block* b){return b->runningKernel == kernel;});
     return true;
 }
 
@@ -404,6 +596,9 @@ SM::recycleResource(Block* block)
     }
 
     resource.remaining_blocks++;
+    resource.remaining_threads += block->resource.threads;
+    resource.remaining_regs    += block->resource.registers * block->warps.size() * GPU_MAX_THREAD_PER_WARP;
+    resource.remaining_shmem   += block->resource.shared_memory;
 }
 
 
@@ -418,12 +613,18 @@ SM::recycleResource(Block* block)
 void
 SM::statistic()
 {
-    isIdel() ? record.exec_cycle++ : record.idle_cycle++;
+    bool idle = isIdel();
+    idle ? record.exec_cycle++ : record.idle_cycle++;
+    idle ? stat_sm_idle_cycle.add() : stat_sm_busy_cycle.add();
 
+    unsigned long long busy_warps = 0;
     for (auto& warp : mWarps)
     {
         warp.second.isBusy ? warp.second.record.computing_cycle++ : warp.second.record.wait_cycle++;
+        busy_warps += warp.second.isBusy;
     }
+    stat_warp_compute_cycle.add(busy_warps);
+    stat_warp_wait_cycle.add(mWarps.size() - busy_warps);
 }
 
 
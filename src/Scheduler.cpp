@@ -6,6 +6,14 @@
  * \date    Jun 22, 2023
  */
 #include "include/Scheduler.hpp"
+#include "include/Statistics.hpp"
+
+/* ************************************************************************************************
+ * Global Variable
+ * ************************************************************************************************
+ */
+/* Statistic, the host time compiling the layers into requests */
+static const Statistics::Counter stat_compile_time = Statistics::instance().counter("host.compile_time", "us");
 
 
 /** ===============================================================================================
@@ -34,16 +42,58 @@ Scheduler::kernelLauncher (Kernel* kernel)
 {
     ASSERT(!kernel->SM_List->empty(), "Kernel has no computing resource");
 
-    if (kernel->compileRequest(&mCPU->mMMU))
+    timeval start, end;
+    gettimeofday(&start, NULL);
+    bool compiled = kernel->compileRequest(&mCPU->mMMU);
+    gettimeofday(&end, NULL);
+    stat_compile_time.add(1000000 * (end.tv_sec - start.tv_sec) + (end.tv_usec - start.tv_usec));
+
+    if (compiled)
     {
         ASSERT(mCPU->mGPU->launchKernel(kernel), "Failed launch kernel");
         kernel->startCycle = total_gpu_cycle;
         kernel->running    = true;
+
+        if (command.PREFETCH_NEXT_KERNEL) prefetchNextKernels(kernel);
     } 
     else log_I("compileRequest", "kernel: " + to_string(kernel->kernelID) + "has empty requests");
 }
 
 
+/** ===============================================================================================
+ * \name    prefetchNextKernels
+ * 
+ * \brief   Stage the filter of the next kernels while the launched kernel is running
+ * 
+ * \param   kernel    the launched kernel, the KernelGroup shares the filter of the front model
+ * 
+ * \endcond
+ * ================================================================================================
+ */
+void 
+Scheduler::prefetchNextKernels (Kernel* kernel)
+{
+    for (auto app : mCPU->mAPPs)
+    {
+        if (app->appID != kernel->appID) continue;
+
+        for (auto model : app->runningModels)
+        {
+            if (model->modelID != kernel->modelID) continue;
+
+            for (auto next_kernel : model->findNextKernels())
+            {
+                auto filter = next_kernel->srcLayer->getFilter();
+                if (!filter.second) continue;
+
+                next_kernel->srcLayer->memoryAllocate(&mCPU->mMMU);
+                mCPU->mGPU->getGMMU()->prefetch(app->appID, mCPU->mMMU.addressTranslate(filter.first));
+            }
+        }
+    }
+}
+
+
 /** ===============================================================================================
  * \name    missDeadlineHandler
  * 
@@ -95,7 +145,7 @@ Scheduler::missDeadlineHandler ()
             string buff = to_string(model->modelID) + " " + model->getModelName() + " with " + to_string(model->getBatchSize()) + " batch size miss deadline! [" + to_string(model->task.arrivalTime) + ", " + to_string(model->task.deadLine) + ", " + to_string(model->startTime) + ", " + to_string(total_gpu_cycle) + "]";
             log_E("Model", buff);
 
-            ofstream file(LOG_OUT_PATH + program_name + ".txt", std::ios::app);
+            LogStream file;
                 file << "App " << model->appID << " Model " << buff << std::endl;
             file.close();
 
@@ -96,7 +96,7 @@ Scheduler_SALBI::WASMD ()
         for (int i = 0; i < sm_num; i++) 
         {
             if (sm_count == system_resource.SM_NUM) break;
-            mCPU->mAPPs[app_pair.first]->SM_budget.insert(sm_count++);
+            mCPU->getApplication(app_pair.first)->SM_budget.insert(sm_count++);
         }
     }
     /* mend up the round to zero issue which remain one SM not allocated */
@@ -134,7 +134,7 @@ Scheduler_SALBI::ORBIS ()
 
     /* Record allocated memory */
     map<int, unsigned long long> NPA_list;
-    for (auto app_pair : NP_list) NPA_list[app_pair.first] += mCPU->mGPU->getGMMU()->getCGroup(app_pair.first)->size() * PAGE_SIZE;
+    for (auto app_pair : NP_list) NPA_list[app_pair.first] += mCPU->mGPU->getGMMU()->getCGroupTarget(app_pair.first) * PAGE_SIZE;
 
     /* Calculate remaining memory */
     for (auto app_pair : NPA_list) memory_budget -= app_pair.second;
@@ -168,7 +168,7 @@ Scheduler_SALBI::ORBIS ()
 
     /* Calculates page fault ratio */
     vector<pair<int, double>> PFR_list;
-    for (auto app_pair : NP_list) PFR_list.emplace_back(make_pair(app_pair.first, NP_list[app_pair.first] * (double)(NP_list[app_pair.first] - NPA_list[app_pair.first] + 1) / mCPU->mAPPs[app_pair.first]->SM_budget.size()));
+    for (auto app_pair : NP_list) PFR_list.emplace_back(make_pair(app_pair.first, NP_list[app_pair.first] * (double)(NP_list[app_pair.first] - NPA_list[app_pair.first] + 1) / mCPU->getApplication(app_pair.first)->SM_budget.size()));
     
     /* Sort in non-decreasing order, the smaller PFR has higher allocation priority */
     sort(PFR_list.begin(), PFR_list.end(), [](auto& a, auto& b){ return a.second < b.second; });
@@ -224,7 +224,7 @@ Scheduler_SALBI::ORBIS ()
     {
         if (NPA_list[app_pair.first] == 0)
         {
-            blocking_SMs.insert(mCPU->mAPPs[app_pair.first]->SM_budget.begin(), mCPU->mAPPs[app_pair.first]->SM_budget.end());
+            blocking_SMs.insert(mCPU->getApplication(app_pair.first)->SM_budget.begin(), mCPU->getApplication(app_pair.first)->SM_budget.end());
         }
     }
 
@@ -232,7 +232,7 @@ Scheduler_SALBI::ORBIS ()
     {
         if (ready_kerenls.find(app_pair.first) != ready_kerenls.end())
         {
-            app_pair.second = NP_list[app_pair.first] * (double)(NP_list[app_pair.first] - NPA_list[app_pair.first] + 1) / (double)(mCPU->mAPPs[app_pair.first]->SM_budget.size() + blocking_SMs.size());
+            app_pair.second = NP_list[app_pair.first] * (double)(NP_list[app_pair.first] - NPA_list[app_pair.first] + 1) / (double)(mCPU->getApplication(app_pair.first)->SM_budget.size() + blocking_SMs.size());
         }
     }
     sort(PFR_list.begin(), PFR_list.end(), [](auto& a, auto& b){ return a.second < b.second; });
@@ -246,13 +246,13 @@ Scheduler_SALBI::ORBIS ()
         if (ready_kerenls.find(app_pair.first) == ready_kerenls.end() ||  NPA_list[app_pair.first] == 0) continue;
 
         auto available_sm = mCPU->mGPU->getIdleSMs();
-        for (auto sm_id : mCPU->mAPPs[app_pair.first]->SM_budget) if (!available_sm.count(sm_id)) continue;
+        for (auto sm_id : mCPU->getApplication(app_pair.first)->SM_budget) if (!available_sm.count(sm_id)) continue;
 
         vector<pair<Kernel*, int>> sync_kernels;
         for (auto kernel : ready_kerenls[app_pair.first]) sync_kernels.push_back(make_pair(kernel, 1));
 
         Kernel* kernel  = new KernelGroup(sync_kernels);
-        kernel->SM_List = new unordered_set<int> (mCPU->mAPPs[app_pair.first]->SM_budget);
+        kernel->SM_List = new unordered_set<int> (mCPU->getApplication(app_pair.first)->SM_budget);
         
         if (!blocking_SMs.empty() && app_pair == PFR_list.front())
         {
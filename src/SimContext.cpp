@@ -0,0 +1,58 @@
+/**
+ * \name    SimContext.cpp
+ *
+ * \brief   Implement the context of a simulation
+ *
+ * \date    Oct 18, 2026
+ */
+
+#include "include/App_config.h"
+#include "include/Log.h"
+
+#include <atomic>
+
+/* ************************************************************************************************
+ * Global Variable
+ * ************************************************************************************************
+ */
+static std::atomic<unsigned long long> contextCount(0);
+
+SimContext main_context;
+
+__thread SimContext* sim_context = &main_context;
+
+
+/** ===============================================================================================
+ * \name    SimContext
+ *
+ * \brief   Create the context with the default command, resource and hardware profile
+ *
+ * \endcond
+ * ================================================================================================
+ */
+SimContext::SimContext() : contextID(contextCount++), hardware(HARDWARE_ARCHITECTURE)
+{
+    storage_count = hardware.page_size;     // the first page in not allow to use
+    pthread_mutex_init(&io_mutex, NULL);
+}
+
+
+/** ===============================================================================================
+ * \name    ~SimContext
+ *
+ * \brief   Flush the log and free the statistic shards of the context
+ *
+ * \endcond
+ * ================================================================================================
+ */
+SimContext::~SimContext()
+{
+    if (log_writer)
+    {
+        log_writer->close();
+        delete log_writer;
+    }
+
+    for (auto shard : stats_shards) delete[] shard;
+    pthread_mutex_destroy(&io_mutex);
+}
@@ -0,0 +1,324 @@
+/**
+ * \name    Statistics.cpp
+ *
+ * \brief   Implement the statistics registry
+ *
+ * \date    Oct 18, 2026
+ */
+
+#include "include/Statistics.hpp"
+
+/* ************************************************************************************************
+ * Global Variable
+ * ************************************************************************************************
+ */
+thread_local unsigned long long* Statistics::local_shard   = nullptr;
+thread_local unsigned long long  Statistics::local_context = 0;
+
+
+/** ===============================================================================================
+ * \name    instance
+ *
+ * \brief   The registry, constructed at the first use so the modules can register their
+ *          statistics in the static initialization
+ *
+ * \endcond
+ * ================================================================================================
+ */
+Statistics&
+Statistics::instance ()
+{
+    static Statistics registry;
+    return registry;
+}
+
+
+/** ===============================================================================================
+ * \name    counter
+ *
+ * \brief   Register the counter, the same name returns the same counter
+ *
+ * \param   name    the name of the counter, "module.value"
+ * \param   unit    the unit of the value
+ *
+ * \endcond
+ * ================================================================================================
+ */
+Statistics::Counter
+Statistics::counter (const string& name, const string& unit)
+{
+    return {registerStat(name, unit, STATS_COUNTER, 1)};
+}
+
+
+/** ===============================================================================================
+ * \name    histogram
+ *
+ * \brief   Register the histogram, the same name returns the same histogram
+ *
+ * \param   name    the name of the histogram, "module.value"
+ * \param   unit    the unit of the recorded values
+ *
+ * \endcond
+ * ================================================================================================
+ */
+Statistics::Histogram
+Statistics::histogram (const string& name, const string& unit)
+{
+    return {registerStat(name, unit, STATS_HISTOGRAM, STATS_HISTOGRAM_HEADER + STATS_HISTOGRAM_BUCKET)};
+}
+
+
+/** ===============================================================================================
+ * \name    registerStat
+ *
+ * \brief   Reserve the slots of the statistic in all shards
+ *
+ * \return  the first slot
+ *
+ * \endcond
+ * ================================================================================================
+ */
+size_t
+Statistics::registerStat (const string& name, const string& unit, StatsType type, size_t size)
+{
+    pthread_mutex_lock(&mutex);
+
+    for (auto& stat : stats)
+    {
+        if (stat.name != name) continue;
+
+        pthread_mutex_unlock(&mutex);
+        ASSERT(stat.type == type, "The statistic " + name + " is registered by another type");
+        return stat.slot;
+    }
+
+    ASSERT(num_of_slot + size <= STATS_MAX_SLOT, "Too many statistics, enlarge STATS_MAX_SLOT");
+    stats.push_back({name, unit, type, num_of_slot});
+    num_of_slot += size;
+
+    pthread_mutex_unlock(&mutex);
+    return stats.back().slot;
+}
+
+
+/** ===============================================================================================
+ * \name    createShard
+ *
+ * \brief   Create the shard of the calling thread at its first update in the context
+ *
+ * \endcond
+ * ================================================================================================
+ */
+unsigned long long*
+Statistics::createShard ()
+{
+    local_shard   = new unsigned long long[STATS_MAX_SLOT]();
+    local_context = sim_context->contextID;
+
+    pthread_mutex_lock(&mutex);
+    sim_context->stats_shards.push_back(local_shard);
+    pthread_mutex_unlock(&mutex);
+
+    return local_shard;
+}
+
+
+/** ===============================================================================================
+ * \name    open
+ *
+ * \brief   Start to write the snapshots into the file
+ *
+ * \param   path        the statistic file, CSV if ends with .csv, otherwise JSON lines
+ * \param   interval    the cycles between the snapshots, 0 for the final snapshot only
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+Statistics::open (const string& path, unsigned long long interval)
+{
+    sim_context->stats_path          = path;
+    sim_context->stats_csv           = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+    sim_context->stats_interval      = interval;
+    sim_context->stats_next_snapshot = interval;
+
+    ofstream file(path, std::ios::out | std::ios::trunc);
+    ASSERT(file.is_open(), "Cannot create the statistic file " + path);
+    if (sim_context->stats_csv) file << "program,cycle,final,name,unit,field,value" << std::endl;
+    file.close();
+}
+
+
+/** ===============================================================================================
+ * \name    cycle
+ *
+ * \brief   Take the snapshot when the interval passes
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+Statistics::cycle ()
+{
+    unsigned long long interval = sim_context->stats_interval;
+    if (!interval || total_gpu_cycle < sim_context->stats_next_snapshot) return;
+
+    snapshot(false);
+    sim_context->stats_next_snapshot = (total_gpu_cycle / interval + 1) * interval;
+}
+
+
+/** ===============================================================================================
+ * \name    close
+ *
+ * \brief   Take the final snapshot
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+Statistics::close ()
+{
+    if (sim_context->stats_path.empty()) return;
+
+    snapshot(true);
+    sim_context->stats_path.clear();
+}
+
+
+/** ===============================================================================================
+ * \name    merge
+ *
+ * \brief   Sum the shards of the context, the maximum of the histograms is merged by max
+ *
+ * \note    The shards are read while the other threads may update them, the simulation updates
+ *          the statistics in the main thread only
+ *
+ * \endcond
+ * ================================================================================================
+ */
+vector<unsigned long long>
+Statistics::merge ()
+{
+    vector<unsigned long long> values(num_of_slot, 0);
+
+    pthread_mutex_lock(&mutex);
+    for (auto shard : sim_context->stats_shards)
+    {
+        for (size_t i = 0; i < num_of_slot; i++) values[i] += shard[i];
+
+        for (auto& stat : stats)
+        {
+            if (stat.type != STATS_HISTOGRAM) continue;
+
+            size_t slot = stat.slot + STATS_HISTOGRAM_MAX;
+            values[slot] -= shard[slot];
+            values[slot]  = max(values[slot], shard[slot]);
+        }
+    }
+    pthread_mutex_unlock(&mutex);
+
+    return values;
+}
+
+
+/** ===============================================================================================
+ * \name    snapshot
+ *
+ * \brief   Append the current values into the file
+ *
+ * \param   final   the snapshot at the end of the simulation
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+Statistics::snapshot (bool final)
+{
+    vector<unsigned long long> values = merge();
+
+    const string& path = sim_context->stats_path;
+    ofstream file(path, std::ios::app);
+    ASSERT(file.is_open(), "Cannot write the statistic file " + path);
+
+    /* The percentile is reported by the lower bound of its bucket */
+    auto percentile = [&values](const Stat& stat, double p) {
+        const unsigned long long* slots = &values[stat.slot];
+        unsigned long long target = ceil(slots[STATS_HISTOGRAM_COUNT] * p), sum = 0;
+        for (size_t i = 0; i < STATS_HISTOGRAM_BUCKET; i++)
+        {
+            sum += slots[STATS_HISTOGRAM_HEADER + i];
+            if (sum >= target && sum) return bucketLowerBound(i);
+        }
+        return 0ULL;
+    };
+
+    stringstream buff;
+    buff << std::fixed << std::setprecision(3);
+
+    if (sim_context->stats_csv)
+    {
+        string prefix = program_name + "," + to_string(total_gpu_cycle) + "," + (final ? "1" : "0") + ",";
+        for (auto& stat : stats)
+        {
+            const unsigned long long* slots = &values[stat.slot];
+            string row = prefix + stat.name + "," + stat.unit + ",";
+            if (stat.type == STATS_COUNTER)
+            {
+                buff << row << "value," << slots[0] << std::endl;
+                continue;
+            }
+
+            unsigned long long count = slots[STATS_HISTOGRAM_COUNT];
+            buff << row << "count," << count << std::endl;
+            buff << row << "mean,"  << (count ? (double)slots[STATS_HISTOGRAM_SUM] / count : 0.0) << std::endl;
+            buff << row << "p50,"   << percentile(stat, 0.5)  << std::endl;
+            buff << row << "p90,"   << percentile(stat, 0.9)  << std::endl;
+            buff << row << "p99,"   << percentile(stat, 0.99) << std::endl;
+            buff << row << "max,"   << slots[STATS_HISTOGRAM_MAX] << std::endl;
+        }
+    }
+    else
+    {
+        buff << "{\"program\":\"" << program_name << "\",\"cycle\":" << total_gpu_cycle << ",\"final\":" << (final ? "true" : "false");
+
+        buff << ",\"counters\":{";
+        bool first = true;
+        for (auto& stat : stats)
+        {
+            if (stat.type != STATS_COUNTER) continue;
+            buff << (first ? "" : ",") << "\"" << stat.name << "\":" << values[stat.slot];
+            first = false;
+        }
+
+        buff << "},\"histograms\":{";
+        first = true;
+        for (auto& stat : stats)
+        {
+            if (stat.type != STATS_HISTOGRAM) continue;
+
+            const unsigned long long* slots = &values[stat.slot];
+            unsigned long long count = slots[STATS_HISTOGRAM_COUNT];
+            buff << (first ? "" : ",") << "\"" << stat.name << "\":{\"unit\":\"" << stat.unit << "\",\"count\":" << count
+                 << ",\"mean\":" << (count ? (double)slots[STATS_HISTOGRAM_SUM] / count : 0.0)
+                 << ",\"p50\":" << percentile(stat, 0.5) << ",\"p90\":" << percentile(stat, 0.9) << ",\"p99\":" << percentile(stat, 0.99)
+                 << ",\"max\":" << slots[STATS_HISTOGRAM_MAX] << ",\"buckets\":[";
+
+            /* The non-empty buckets, [lower bound, count] */
+            bool first_bucket = true;
+            for (size_t i = 0; i < STATS_HISTOGRAM_BUCKET; i++)
+            {
+                if (!slots[STATS_HISTOGRAM_HEADER + i]) continue;
+                buff << (first_bucket ? "" : ",") << "[" << bucketLowerBound(i) << "," << slots[STATS_HISTOGRAM_HEADER + i] << "]";
+                first_bucket = false;
+            }
+            buff << "]}";
+            first = false;
+        }
+        buff << "}}" << std::endl;
+    }
+
+    file << buff.str();
+    file.close();
+}
@@ -0,0 +1,252 @@
+/**
+ * \name    Timeline.cpp
+ *
+ * \brief   Implement the timeline writer
+ *
+ * \date    Oct 18, 2026
+ */
+
+#include "include/Timeline.hpp"
+#include "include/Kernel.hpp"
+
+/** ===============================================================================================
+ * \name    TimelineWriter
+ *
+ * \brief   Create the timeline file and start the writer thread
+ *
+ * \param   path    the timeline file
+ *
+ * \endcond
+ * ================================================================================================
+ */
+TimelineWriter::TimelineWriter(const string& path) : path(path)
+{
+    file.open(path, std::ios::out | std::ios::trunc);
+    ASSERT(file.is_open(), "Cannot create the timeline " + path);
+
+    buffer.reserve(TIMELINE_BUFFER_SIZE);
+    buffer += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+    ASSERT(pthread_create(&writer, NULL, writeThread, this) == 0, "Cannot create the timeline writer");
+
+    nameTrack(TIMELINE_GMMU, TIMELINE_FAULT_BATCH, "Fault batch");
+    nameTrack(TIMELINE_GMMU, TIMELINE_PCIE,        "PCIe");
+}
+
+
+/** ===============================================================================================
+ * \name    ~TimelineWriter
+ *
+ * \brief   Close the event list and wait for the writer thread
+ *
+ * \endcond
+ * ================================================================================================
+ */
+TimelineWriter::~TimelineWriter()
+{
+    buffer += "\n]}\n";
+    flush();
+
+    pthread_mutex_lock(&mutex);
+    closing = true;
+    pthread_cond_signal(&cond);
+    pthread_mutex_unlock(&mutex);
+    pthread_join(writer, NULL);
+
+    file.close();
+
+    log_W("TimelineWriter", to_string(event_count) + " events are written into " + path);
+}
+
+
+/** ===============================================================================================
+ * \name    recordKernel
+ *
+ * \brief   Record the finished kernel on the track of its application and its blocks on the tracks
+ *          of the SMs
+ *
+ * \param   kernel  the finished kernel
+ * \param   name    the name shown on the timeline
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TimelineWriter::recordKernel (Kernel* kernel, const string& name)
+{
+    nameTrack(TIMELINE_APPLICATION, kernel->appID, "App " + to_string(kernel->appID));
+
+    string sm_list;
+    if (kernel->SM_List) for (auto sm_id : *kernel->SM_List) sm_list += (sm_list.empty() ? "" : " ") + to_string(sm_id);
+
+    completeEvent(TIMELINE_APPLICATION, kernel->appID, name, kernel->startCycle, kernel->endCycle,
+                  "\"model\":" + to_string(kernel->modelID) + ",\"sm\":\"" + sm_list + "\"");
+
+    for (auto& block : kernel->block_record)
+    {
+        nameTrack(TIMELINE_SM, block.sm_id, "SM " + to_string(block.sm_id));
+        completeEvent(TIMELINE_SM, block.sm_id, name, block.start_cycle, block.end_cycle,
+                      "\"block\":" + to_string(block.block_id) + ",\"app\":" + to_string(kernel->appID)
+                      + ",\"access\":" + to_string(block.launch_access_counter) + ",\"page\":" + to_string(block.access_page_counter));
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    recordFaultBatch
+ *
+ * \brief   Record the fault batch finished in this cycle
+ *
+ * \param   start_cycle     the cycle the batch is issued
+ * \param   num_of_page     the demanded pages of the batch
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TimelineWriter::recordFaultBatch (unsigned long long start_cycle, unsigned long long num_of_page)
+{
+    completeEvent(TIMELINE_GMMU, TIMELINE_FAULT_BATCH, "Fault batch", start_cycle, total_gpu_cycle,
+                  "\"page\":" + to_string(num_of_page));
+}
+
+
+/** ===============================================================================================
+ * \name    recordTransfer
+ *
+ * \brief   Record the page transfer over PCIe, each takes PAGE_FAULT_MIGRATION_UNIT_CYCLE
+ *
+ * \param   name            the type of transfer
+ * \param   app_id          the application of the page
+ * \param   page_id         the transferred page
+ * \param   start_cycle     the GPU cycle the transfer starts
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TimelineWriter::recordTransfer (const string& name, int app_id, unsigned long long page_id, double start_cycle)
+{
+    double duration = PAGE_FAULT_MIGRATION_UNIT_CYCLE * GPU_F / GMMU_F;
+    completeEvent(TIMELINE_GMMU, TIMELINE_PCIE, name, start_cycle, start_cycle + duration,
+                  "\"app\":" + to_string(app_id) + ",\"page\":" + to_string(page_id));
+}
+
+
+/** ===============================================================================================
+ * \name    completeEvent
+ *
+ * \brief   Append the complete event, the cycles are converted into us by GPU_F
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TimelineWriter::completeEvent (TimelineProcess pid, int tid, const string& name, double start_cycle, double end_cycle, const string& args)
+{
+    char time[64];
+    snprintf(time, sizeof(time), "\"ts\":%.3f,\"dur\":%.3f", start_cycle / GPU_F * 1e6, max(end_cycle - start_cycle, 0.0) / GPU_F * 1e6);
+
+    appendEvent("{\"name\":\"" + name + "\",\"ph\":\"X\"," + time + ",\"pid\":" + to_string(pid) + ",\"tid\":" + to_string(tid)
+              + ",\"args\":{" + args + "}}");
+}
+
+
+/** ===============================================================================================
+ * \name    nameTrack
+ *
+ * \brief   Name the process and the track by the metadata events at their first use
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TimelineWriter::nameTrack (TimelineProcess pid, int tid, const string& name)
+{
+    static const char* process_names[] = {"SM", "Application", "GMMU"};
+
+    if (named_tracks.insert({pid, -1}).second)
+    {
+        appendEvent("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" + to_string(pid) + ",\"args\":{\"name\":\"" + process_names[pid] + "\"}}");
+        appendEvent("{\"name\":\"process_sort_index\",\"ph\":\"M\",\"pid\":" + to_string(pid) + ",\"args\":{\"sort_index\":" + to_string(pid) + "}}");
+    }
+    if (named_tracks.insert({pid, tid}).second)
+    {
+        appendEvent("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + to_string(pid) + ",\"tid\":" + to_string(tid) + ",\"args\":{\"name\":\"" + name + "\"}}");
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    appendEvent
+ *
+ * \brief   Append the event into the buffer, the full buffer is handed to the writer thread
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TimelineWriter::appendEvent (const string& event)
+{
+    if (event_count++) buffer += ",\n";
+    buffer += event;
+
+    if (buffer.size() >= TIMELINE_BUFFER_SIZE) flush();
+}
+
+
+/** ===============================================================================================
+ * \name    flush
+ *
+ * \brief   Hand the buffer to the writer thread
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TimelineWriter::flush ()
+{
+    string chunk;
+    chunk.reserve(TIMELINE_BUFFER_SIZE);
+    chunk.swap(buffer);
+
+    pthread_mutex_lock(&mutex);
+    chunks.emplace_back(move(chunk));
+    pthread_cond_signal(&cond);
+    pthread_mutex_unlock(&mutex);
+}
+
+
+/** ===============================================================================================
+ * \name    writeThread
+ *
+ * \brief   Write the handed buffers into the file until the writer is closed
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void*
+TimelineWriter::writeThread (void* arg)
+{
+    TimelineWriter* writer = (TimelineWriter*)arg;
+
+    while (1)
+    {
+        pthread_mutex_lock(&writer->mutex);
+        while (writer->chunks.empty() && !writer->closing) pthread_cond_wait(&writer->cond, &writer->mutex);
+
+        if (writer->chunks.empty())
+        {
+            pthread_mutex_unlock(&writer->mutex);
+            break;
+        }
+
+        string chunk = move(writer->chunks.front());
+        writer->chunks.pop_front();
+        pthread_mutex_unlock(&writer->mutex);
+
+        writer->file.write(chunk.data(), chunk.size());
+    }
+
+    return NULL;
+}
@@ -0,0 +1,692 @@
+/**
+ * \name    Trace.cpp
+ *
+ * \brief   Implement the access trace recorder and the trace replay front end
+ *
+ * \date    Oct 18, 2026
+ */
+
+#include "include/Trace.hpp"
+#include "include/GPU.hpp"
+#include "include/GMMU.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* ************************************************************************************************
+ * Global Variable
+ * ************************************************************************************************
+ */
+/* The thread of the access, (sm, warp, thread) */
+static inline unsigned long long
+threadKey (int sm_id, int warp_id, int thread_id)
+{
+    return ((unsigned long long)sm_id << 32) | ((unsigned long long)warp_id << 16) | (unsigned long long)thread_id;
+}
+
+
+/** ===============================================================================================
+ * \name    TraceRecorder
+ *
+ * \brief   Create the trace file
+ *
+ * \param   path    the trace file
+ *
+ * \endcond
+ * ================================================================================================
+ */
+TraceRecorder::TraceRecorder(const string& path) : path(path)
+{
+    file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    ASSERT(file.is_open(), "Cannot create the trace " + path);
+
+    buffer.reserve(TRACE_BUFFER_SIZE);
+    buffer += TRACE_MAGIC;
+    writeVarint(TRACE_VERSION);
+}
+
+
+/** ===============================================================================================
+ * \name    ~TraceRecorder
+ *
+ * \brief   Close the trace with the end record
+ *
+ * \endcond
+ * ================================================================================================
+ */
+TraceRecorder::~TraceRecorder()
+{
+    recordEvent(TRACE_END, {(long long)max_page});
+    flush();
+    file.close();
+
+    log_W("TraceRecorder", to_string(access_count) + " accesses are recorded into " + path);
+}
+
+
+/** ===============================================================================================
+ * \name    launchKernel
+ *
+ * \brief   Record the kernel bound to the SMs
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceRecorder::launchKernel (Kernel* kernel)
+{
+    launch_cycles[kernel->kernelID]  = total_gpu_cycle;
+    kernel_returns[kernel->kernelID] = total_gpu_cycle;
+
+    recordEvent(TRACE_LAUNCH, {kernel->kernelID, kernel->appID, kernel->modelID});
+}
+
+
+/** ===============================================================================================
+ * \name    finishKernel
+ *
+ * \brief   Record the finished kernel, the replay finishes the kernel by the same cycles after its
+ *          last access returns
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceRecorder::finishKernel (Kernel* kernel)
+{
+    if (!launch_cycles.count(kernel->kernelID)) return;
+
+    recordEvent(TRACE_FINISH, {kernel->kernelID, (long long)(total_gpu_cycle - kernel_returns[kernel->kernelID])});
+
+    finish_count++;
+    finish_cycle = total_gpu_cycle;
+    launch_cycles.erase(kernel->kernelID);
+    kernel_returns.erase(kernel->kernelID);
+}
+
+
+/** ===============================================================================================
+ * \name    issueAccess
+ *
+ * \brief   Record the access collected by the GMMU
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceRecorder::issueAccess (MemoryAccess* access)
+{
+    auto key = threadKey(access->sm_id, access->warp_id, access->thread_id);
+    auto it  = thread_returns.find(key);
+    unsigned long long ready_cycle = launch_cycles[access->kernel_id];
+    if (it != thread_returns.end()) ready_cycle = max(ready_cycle, it->second);
+
+    buffer += (access->type == Read) ? TRACE_READ : TRACE_WRITE;
+    writeVarint(total_gpu_cycle - last_cycle);
+    writeSigned(access->kernel_id - prev_kernel);
+    writeVarint(access->sm_id);
+    writeVarint(access->warp_id);
+    writeVarint(access->thread_id);
+    writeVarint(total_gpu_cycle - ready_cycle);
+    writePages(access->pageIDs, prev_page);
+
+    last_cycle  = total_gpu_cycle;
+    prev_kernel = access->kernel_id;
+    access_count++;
+
+    if (buffer.size() >= TRACE_BUFFER_SIZE) flush();
+}
+
+
+/** ===============================================================================================
+ * \name    returnAccess
+ *
+ * \brief   Keep the return cycle of the access for the gap of the next access of the thread
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceRecorder::returnAccess (MemoryAccess* access)
+{
+    thread_returns[threadKey(access->sm_id, access->warp_id, access->thread_id)] = total_gpu_cycle;
+
+    auto it = kernel_returns.find(access->kernel_id);
+    if (it != kernel_returns.end()) it->second = total_gpu_cycle;
+}
+
+
+/** ===============================================================================================
+ * \name    recordEvent
+ *
+ * \brief   Record the control of the GMMU or the kernel
+ *
+ * \param   tag     the type of record
+ * \param   args    the arguments of the record
+ * \param   pages   the pages of the record
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceRecorder::recordEvent (TraceTag tag, const vector<long long>& args, const vector<unsigned long long>& pages)
+{
+    buffer += tag;
+    writeVarint(total_gpu_cycle - last_cycle);
+    writeVarint(finish_count);
+    writeVarint(total_gpu_cycle - finish_cycle);
+    writeVarint(args.size());
+    for (auto arg : args) writeSigned(arg);
+
+    unsigned long long prev_event_page = 0;
+    writePages(pages, prev_event_page);
+
+    last_cycle = total_gpu_cycle;
+
+    if (buffer.size() >= TRACE_BUFFER_SIZE) flush();
+}
+
+
+/** ===============================================================================================
+ * \name    writeVarint
+ *
+ * \brief   Append the unsigned LEB128 value
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceRecorder::writeVarint (unsigned long long value)
+{
+    while (value >= 0x80)
+    {
+        buffer += (char)(value | 0x80);
+        value >>= 7;
+    }
+    buffer += (char)value;
+}
+
+
+/** ===============================================================================================
+ * \name    writePages
+ *
+ * \brief   Append the page list, the first page is delta encoded to prev_page and the others to
+ *          the previous page of the list
+ *
+ * \param   pages       the pages
+ * \param   prev_page   the reference of the first page, updated to the first page of the list
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceRecorder::writePages (const vector<unsigned long long>& pages, unsigned long long& prev_page)
+{
+    writeVarint(pages.size());
+
+    unsigned long long prev = prev_page;
+    for (auto page_id : pages)
+    {
+        writeSigned((long long)(page_id - prev));
+        prev = page_id;
+        max_page = max(max_page, page_id);
+    }
+    if (!pages.empty()) prev_page = pages.front();
+}
+
+
+/** ===============================================================================================
+ * \name    flush
+ *
+ * \brief   Write the buffered records into the file
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceRecorder::flush ()
+{
+    file.write(buffer.data(), buffer.size());
+    buffer.clear();
+}
+
+
+/** ===============================================================================================
+ * \name    TraceReplayer
+ *
+ * \brief   Load the trace and create the recorded pages
+ *
+ * \param   path    the trace file
+ * \param   gmmu    the GMMU fed by the trace
+ * \param   mc      the memory controller owning the pages
+ *
+ * \endcond
+ * ================================================================================================
+ */
+TraceReplayer::TraceReplayer(const string& path, GMMU* gmmu, MemoryController* mc) : path(path), mGMMU(gmmu), mMC(mc)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    ASSERT(fd >= 0, "Cannot open the trace " + path);
+
+    struct stat info;
+    ASSERT(fstat(fd, &info) == 0 && info.st_size > 0, "Cannot read the trace " + path);
+
+    void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ASSERT(data != MAP_FAILED, "Cannot map the trace " + path);
+
+    parse((const unsigned char*)data, info.st_size);
+
+    munmap(data, info.st_size);
+    close(fd);
+
+    /* The pages are numbered from 1 as the memory controller allocates them */
+    if (max_page) mMC->memoryAllocate(max_page * PAGE_SIZE);
+}
+
+
+/** ===============================================================================================
+ * \name    ~TraceReplayer
+ *
+ * \brief   Destruct TraceReplayer
+ *
+ * \endcond
+ * ================================================================================================
+ */
+TraceReplayer::~TraceReplayer()
+{
+    for (auto& access : inflight_accesses) delete access.first;
+}
+
+
+/** ===============================================================================================
+ * \name    parse
+ *
+ * \brief   Decode the records of the trace
+ *
+ * \param   data    the mapped trace
+ * \param   size    the size of the trace
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceReplayer::parse (const unsigned char* data, size_t size)
+{
+    size_t pos = 0;
+    auto readVarint = [&]() {
+        unsigned long long value = 0;
+        for (int shift = 0;; shift += 7)
+        {
+            ASSERT(pos < size && shift < 64, "Truncated trace " + path);
+            unsigned char byte = data[pos++];
+            value |= (unsigned long long)(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+    };
+    auto readSigned = [&]() {
+        unsigned long long value = readVarint();
+        return (long long)(value >> 1) ^ -(long long)(value & 1);
+    };
+    auto readPages = [&](vector<unsigned long long>& list, unsigned long long& prev_page) {
+        unsigned long long count = readVarint(), prev = prev_page;
+        for (unsigned long long i = 0; i < count; i++)
+        {
+            prev += readSigned();
+            list.emplace_back(prev);
+        }
+        if (count) prev_page = list[list.size() - count];
+        return count;
+    };
+
+    size_t magic_size = strlen(TRACE_MAGIC);
+    ASSERT(size >= magic_size && !memcmp(data, TRACE_MAGIC, magic_size), path + " is not a trace");
+    pos = magic_size;
+    ASSERT(readVarint() == TRACE_VERSION, "Unsupported trace version of " + path);
+
+    unsigned long long cycle = 0, prev_page = 0;
+    int kernel_id = 0;
+    bool end = false;
+    while (pos < size && !end)
+    {
+        TraceTag tag = (TraceTag)data[pos++];
+        cycle += readVarint();
+
+        if (tag == TRACE_READ || tag == TRACE_WRITE)
+        {
+            AccessTrace access;
+            access.kernel_id   = (kernel_id += readSigned());
+            access.sm_id       = readVarint();
+            access.warp_id     = readVarint();
+            access.thread_id   = readVarint();
+            access.type        = (tag == TRACE_READ) ? Read : Write;
+            access.gap         = readVarint();
+            access.page_offset = pages.size();
+            access.page_count  = readPages(pages, prev_page);
+
+            ASSERT(kernels.count(access.kernel_id), path + ": access of the kernel " + to_string(access.kernel_id) + " before its launch");
+            auto& kernel = kernels[access.kernel_id];
+            kernel.threads[threadKey(access.sm_id, access.warp_id, access.thread_id)].emplace_back(accesses.size());
+            kernel.remaining++;
+            accesses.emplace_back(access);
+            continue;
+        }
+
+        EventTrace event;
+        event.tag          = tag;
+        event.cycle        = cycle;
+        event.finish_count = readVarint();
+        event.delay        = readVarint();
+        unsigned long long num_of_arg = readVarint();
+        for (unsigned long long i = 0; i < num_of_arg; i++) event.args.emplace_back(readSigned());
+        unsigned long long prev_event_page = 0;
+        readPages(event.pages, prev_event_page);
+
+        switch (tag)
+        {
+            case TRACE_LAUNCH:
+                ASSERT(event.args.size() == 3, path + ": broken launch record");
+                kernels[event.args[0]].app_id        = event.args[1];
+                kernels[event.args[0]].model_id      = event.args[2];
+                kernels[event.args[0]].record_launch = cycle;
+                break;
+            case TRACE_FINISH:
+                ASSERT(event.args.size() == 2 && kernels.count(event.args[0]), path + ": broken finish record");
+                kernels[event.args[0]].tail          = event.args[1];
+                kernels[event.args[0]].record_finish = cycle;
+                continue;
+            case TRACE_END:
+                ASSERT(event.args.size() == 1, path + ": broken end record");
+                max_page         = event.args[0];
+                record_end_cycle = cycle;
+                end = true;
+                continue;
+            case TRACE_CGROUP_SIZE: case TRACE_CGROUP_TYPE: case TRACE_CGROUP_FREE:
+            case TRACE_PREFETCH:    case TRACE_TERMINATE:   case TRACE_RELEASE:
+                break;
+            default:
+                ASSERT(false, path + ": unknown record " + string(1, tag));
+        }
+        events.emplace_back(move(event));
+    }
+    ASSERT(end, "Truncated trace " + path + ", the recording simulation did not finish");
+}
+
+
+/** ===============================================================================================
+ * \name    cycle
+ *
+ * \brief   Finish the kernels, apply the ready controls and issue the ready accesses to the GMMU,
+ *          called before the GMMU cycle
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceReplayer::cycle ()
+{
+    while (!finishing_kernels.empty() && finishing_kernels.top().first <= total_gpu_cycle)
+    {
+        auto finish = finishing_kernels.top();
+        finishing_kernels.pop();
+
+        auto& kernel = kernels[finish.second];
+        finish_cycles.emplace_back(finish.first);
+        running_kernels--;
+
+        LogStream file;
+            file << "Finish kernel [" << finish.second << "] (Trace): [" << kernel.launch_cycle << ", " << finish.first << "]"
+                 << ", recorded: [" << kernel.record_launch << ", " << kernel.record_finish << "]" << std::endl;
+        file.close();
+    }
+
+    while (next_event < events.size() && isEventReady(events[next_event])) applyEvent(events[next_event++]);
+
+    while (!ready_accesses.empty() && ready_accesses.top().first <= total_gpu_cycle)
+    {
+        size_t index = ready_accesses.top().second;
+        ready_accesses.pop();
+        issueAccess(index);
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    isEventReady
+ *
+ * \brief   Check whether the kernels finished before the control are finished and the recorded
+ *          delay passed
+ *
+ * \endcond
+ * ================================================================================================
+ */
+bool
+TraceReplayer::isEventReady (const EventTrace& event)
+{
+    if (finish_cycles.size() <= event.finish_count) return false;
+
+    return finish_cycles[event.finish_count] + event.delay <= total_gpu_cycle;
+}
+
+
+/** ===============================================================================================
+ * \name    applyEvent
+ *
+ * \brief   Replay the control on the GMMU
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceReplayer::applyEvent (const EventTrace& event)
+{
+    auto& args = event.args;
+    switch (event.tag)
+    {
+        case TRACE_LAUNCH:
+            launchKernel(args[0], finish_cycles[event.finish_count] + event.delay);
+            break;
+
+        /* The budget over the VRAM is given by the recorded VRAM size */
+        case TRACE_CGROUP_SIZE:
+            mGMMU->setCGroupSize(args[0], min((unsigned long long)args[1], (unsigned long long)(system_resource.VRAM_SPACE / PAGE_SIZE)), args[2]);
+            break;
+
+        case TRACE_CGROUP_TYPE:
+            mGMMU->setCGroupType(args[0]);
+            break;
+
+        case TRACE_CGROUP_FREE:
+            mGMMU->freeCGroup(args[0]);
+            break;
+
+        case TRACE_PREFETCH:
+            mGMMU->prefetch(args[0], event.pages, args[1]);
+            break;
+
+        case TRACE_TERMINATE:
+            for (auto& kernel : kernels)
+            {
+                if (kernel.second.app_id != args[0] || kernel.second.model_id != args[1] || kernel.second.terminated) continue;
+
+                kernel.second.terminated = true;
+                kernel.second.threads.clear();
+            }
+            mGMMU->terminateModel(args[0], args[1]);
+            break;
+
+        /* As the memory controller releases the pages */
+        case TRACE_RELEASE:
+            for (auto page_id : event.pages)
+            {
+                Page* page = mMC->refer(page_id);
+                page->record   = {};
+                page->location = SPACE_DRAM;
+                page->dirty    = false;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    launchKernel
+ *
+ * \brief   Schedule the first access of each thread of the kernel
+ *
+ * \param   kernel_id       the launched kernel
+ * \param   launch_cycle    the launch cycle gated by the finished kernels
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceReplayer::launchKernel (int kernel_id, unsigned long long launch_cycle)
+{
+    auto& kernel = kernels[kernel_id];
+    kernel.launch_cycle = launch_cycle;
+    running_kernels++;
+
+    if (!kernel.remaining)
+    {
+        finishing_kernels.emplace(launch_cycle + kernel.tail, kernel_id);
+        return;
+    }
+
+    for (auto& thread : kernel.threads)
+    {
+        size_t index = thread.second.front();
+        thread.second.pop_front();
+
+        auto it = thread_returns.find(thread.first);
+        unsigned long long ready_cycle = (it != thread_returns.end()) ? max(launch_cycle, it->second) : launch_cycle;
+        ready_accesses.emplace(ready_cycle + accesses[index].gap, index);
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    issueAccess
+ *
+ * \brief   Push the access into the GMMU as the SM does
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceReplayer::issueAccess (size_t index)
+{
+    auto& trace  = accesses[index];
+    auto& kernel = kernels[trace.kernel_id];
+    if (kernel.terminated) return;
+
+    MemoryAccess* access = new MemoryAccess(kernel.app_id, kernel.model_id, trace.kernel_id, trace.sm_id, -1, trace.warp_id, trace.thread_id, -1, trace.type);
+    access->pageIDs.assign(pages.begin() + trace.page_offset, pages.begin() + trace.page_offset + trace.page_count);
+
+    inflight_accesses[access] = index;
+    mGMMU->issueAccess(access);
+}
+
+
+/** ===============================================================================================
+ * \name    returnAccess
+ *
+ * \brief   Receive the finished access from the GMMU, the next access of the thread is issued
+ *          after the recorded gap
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceReplayer::returnAccess (MemoryAccess* access)
+{
+    auto it = inflight_accesses.find(access);
+    ASSERT(it != inflight_accesses.end(), "Return the access not issued by the trace");
+
+    auto& trace  = accesses[it->second];
+    auto& kernel = kernels[trace.kernel_id];
+    auto key = threadKey(trace.sm_id, trace.warp_id, trace.thread_id);
+    thread_returns[key] = total_gpu_cycle;
+
+    inflight_accesses.erase(it);
+    delete access;
+
+    if (kernel.terminated) return;
+
+    auto& thread = kernel.threads[key];
+    if (!thread.empty())
+    {
+        ready_accesses.emplace(total_gpu_cycle + accesses[thread.front()].gap, thread.front());
+        thread.pop_front();
+    }
+
+    if (--kernel.remaining == 0) finishing_kernels.emplace(total_gpu_cycle + kernel.tail, trace.kernel_id);
+}
+
+
+/** ===============================================================================================
+ * \name    isFinish
+ *
+ * \brief   Check whether all records are replayed
+ *
+ * \endcond
+ * ================================================================================================
+ */
+bool
+TraceReplayer::isFinish ()
+{
+    return next_event == events.size() && finishing_kernels.empty() && ready_accesses.empty() && inflight_accesses.empty();
+}
+
+
+/** ===============================================================================================
+ * \name    nextEventCycle
+ *
+ * \brief   The cycle of the next access, kernel finish or control
+ *
+ * \return  the current cycle while the accesses are in the GMMU, -1 if nothing to replay
+ *
+ * \endcond
+ * ================================================================================================
+ */
+unsigned long long
+TraceReplayer::nextEventCycle ()
+{
+    if (!inflight_accesses.empty()) return total_gpu_cycle;
+
+    unsigned long long next_cycle = -1;
+    if (!ready_accesses.empty())    next_cycle = min(next_cycle, ready_accesses.top().first);
+    if (!finishing_kernels.empty()) next_cycle = min(next_cycle, finishing_kernels.top().first);
+
+    if (next_event < events.size() && finish_cycles.size() > events[next_event].finish_count)
+    {
+        next_cycle = min(next_cycle, finish_cycles[events[next_event].finish_count] + events[next_event].delay);
+    }
+
+    return max(next_cycle, total_gpu_cycle);
+}
+
+
+/** ===============================================================================================
+ * \name    printInfo
+ *
+ * \brief   Print the replayed cycles against the recorded cycles
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+TraceReplayer::printInfo ()
+{
+    stringstream buff;
+    buff << "Replay trace: " << path << ", kernels: " << kernels.size() << ", accesses: " << accesses.size()
+         << ", cycles: " << total_gpu_cycle << " (recorded: " << record_end_cycle << ")" << std::endl;
+
+    std::cout << buff.str();
+    LogStream file;
+        file << buff.str();
+    file.close();
+}
@@ -0,0 +1,143 @@
+/**
+ * \name    WarpScheduler.cpp
+ *
+ * \brief   Implement the warp scheduler
+ *
+ * \date    Oct 18, 2026
+ */
+
+#include "include/WarpScheduler.hpp"
+#include "include/SM.hpp"
+
+/** ===============================================================================================
+ * \name    schedule
+ *
+ * \brief   Select at most GPU_ISSUE_WIDTH ready warps by command.WARP_SCHEDULER_MODE
+ *
+ * \param   warps   the busy warps of the scheduler in the order of warpID
+ * \param   issued  the issued warps are appended
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+WarpScheduler::schedule (const vector<Warp*>& warps, vector<Warp*>& issued)
+{
+    switch (command.WARP_SCHEDULER_MODE)
+    {
+        case GTO:       GTO_Schedule(warps, issued);      break;
+        case LRR:       LRR_Schedule(warps, issued);      break;
+        case TWO_LEVEL: TwoLevel_Schedule(warps, issued); break;
+        default: ASSERT(false, "Unlimited issue has no warp scheduler");
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    GTO_Schedule
+ *
+ * \brief   Greedy-Then-Oldest, issue the last issued warp until it stalls, then the oldest ready
+ *          warp, the warp bound to its block first
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+WarpScheduler::GTO_Schedule (const vector<Warp*>& warps, vector<Warp*>& issued)
+{
+    size_t first = issued.size();
+    if (greedyWarp && greedyWarp->isReady()) issued.push_back(greedyWarp);
+
+    vector<Warp*> ready;
+    for (auto warp : warps) if (warp != greedyWarp && warp->isReady()) ready.push_back(warp);
+
+    size_t count = min(ready.size(), (size_t)GPU_ISSUE_WIDTH - (issued.size() - first));
+    partial_sort(ready.begin(), ready.begin() + count, ready.end(), [](Warp* a, Warp* b){
+        return make_pair(a->record.start_cycle, a->warpID) < make_pair(b->record.start_cycle, b->warpID);
+    });
+    issued.insert(issued.end(), ready.begin(), ready.begin() + count);
+
+    greedyWarp = (issued.size() > first) ? issued[first] : nullptr;
+}
+
+
+/** ===============================================================================================
+ * \name    LRR_Schedule
+ *
+ * \brief   Loose Round Robin, issue the ready warps following the last issued warp in the order of
+ *          warpID
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+WarpScheduler::LRR_Schedule (const vector<Warp*>& warps, vector<Warp*>& issued)
+{
+    size_t start = 0;
+    while (start < warps.size() && warps[start]->warpID <= lastWarpID) start++;
+
+    int count = 0;
+    for (size_t i = 0; i < warps.size() && count < GPU_ISSUE_WIDTH; i++)
+    {
+        Warp* warp = warps[(start + i) % warps.size()];
+        if (!warp->isReady()) continue;
+
+        issued.push_back(warp);
+        lastWarpID = warp->warpID;
+        count++;
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    TwoLevel_Schedule
+ *
+ * \brief   Two-level scheduling, the active warps are issued round robin. The active warp stalled
+ *          on its accesses is moved to the pending warps, the ready pending warps fill the active
+ *          set up to TWO_LEVEL_ACTIVE_WARP in FIFO order.
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+WarpScheduler::TwoLevel_Schedule (const vector<Warp*>& warps, vector<Warp*>& issued)
+{
+    /* The finished warps leave, the newly bound warps start as pending */
+    auto finish = [this](Warp* warp) {
+        if (warp->isBusy) return false;
+        trackedWarps[warp->warpID] = false;
+        return true;
+    };
+    activeWarps.remove_if(finish);
+    pendingWarps.remove_if(finish);
+
+    for (auto warp : warps)
+    {
+        if (trackedWarps[warp->warpID]) continue;
+
+        trackedWarps[warp->warpID] = true;
+        pendingWarps.push_back(warp);
+    }
+
+    /* Demote the stalled warps */
+    for (auto warp = activeWarps.begin(); warp != activeWarps.end();)
+    {
+        if ((*warp)->isReady()) warp++;
+        else pendingWarps.splice(pendingWarps.end(), activeWarps, warp++);
+    }
+
+    /* Promote the ready warps */
+    for (auto warp = pendingWarps.begin(); warp != pendingWarps.end() && activeWarps.size() < TWO_LEVEL_ACTIVE_WARP;)
+    {
+        if ((*warp)->isReady()) activeWarps.splice(activeWarps.end(), pendingWarps, warp++);
+        else warp++;
+    }
+
+    /* Issue round robin, the issued warp goes to the back */
+    size_t count = min(activeWarps.size(), (size_t)GPU_ISSUE_WIDTH);
+    for (size_t i = 0; i < count; i++)
+    {
+        issued.push_back(activeWarps.front());
+        activeWarps.splice(activeWarps.end(), activeWarps, activeWarps.begin());
+    }
+}
@@ -0,0 +1,289 @@
+/**
+ * \name    bench.cpp
+ *
+ * \brief   The throughput benchmark of the simulator, run by make bench
+ *
+ * \note    Each case runs ./GPGPU alone with --stats, the simulated cycles and the host compile and
+ *          run time are read from the final snapshot, the peak RSS from the rusage of the child.
+ *          The result is written into BENCH_PATH/result.json and compared with the baseline.
+ *
+ * \date    Oct 18, 2026
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+/* ************************************************************************************************
+ * Name Space
+ * ************************************************************************************************
+ */
+using namespace std;
+
+/* ************************************************************************************************
+ * Software Configuration
+ * ************************************************************************************************
+ */
+#define SIMULATOR           "./GPGPU"
+#define BENCH_PATH          "./bench/"
+#define BENCH_SM_NUM        "8"
+#define BENCH_TOLERANCE     0.1                 // the throughput drop reported as regression
+
+/* The fixed matrix, each model runs alone with each scheduler, batch size and VRAM budget */
+const vector<string> BENCH_MODELS     = {"LeNet", "CaffeNet", "ResNet18", "GoogleNet", "VGG16", "SqueezeNet"};
+const vector<string> BENCH_SCHEDULERS = {"Baseline", "Average", "BARM", "SALBI"};
+const vector<int>    BENCH_BATCHES    = {1, 4};
+const vector<int>    BENCH_VRAM_PAGES = {256, 4096};
+
+/* ************************************************************************************************
+ * Type Define
+ * ************************************************************************************************
+ */
+struct BenchResult {
+    string name;
+    vector<string> args;
+
+    bool finished = false;
+    unsigned long long cycles = 0;
+    double wall_ms = 0, compile_ms = 0, run_ms = 0;
+    long peak_rss_kb = 0;
+
+    double throughput () const {return wall_ms > 0 ? cycles / (wall_ms / 1000) : 0;}
+};
+
+/* ************************************************************************************************
+ * Function Declaration
+ * ************************************************************************************************
+ */
+void runCase (BenchResult& result, int timeout);
+bool readValue (const string& text, const string& key, double& value);
+map<string, BenchResult> loadResults (const string& path);
+void saveResults (const string& path, const vector<BenchResult>& results);
+
+/** ===============================================================================================
+ * \name    main
+ *
+ * \brief   Run the matrix and compare with the baseline
+ *
+ * \param   --filter [text]     run the cases whose name contains the text only
+ * \param   --timeout [s]       kill the case after s seconds, 0 for no limit
+ * \param   --update            save the result as the new baseline
+ *
+ * \return  1 if the throughput of any case drops more than BENCH_TOLERANCE from the baseline
+ *
+ * \endcond
+ * ================================================================================================
+ */
+int main(int argc, char** argv)
+{
+    string filter;
+    int timeout = 0;
+    bool update = false;
+    for (int i = 1; i < argc; i++)
+    {
+        string flag = argv[i];
+        if (flag == "--filter" && i + 1 < argc)       filter  = argv[++i];
+        else if (flag == "--timeout" && i + 1 < argc) timeout = atoi(argv[++i]);
+        else if (flag == "--update")                  update  = true;
+        else {cout << "Usage: BENCH [--filter text] [--timeout s] [--update]" << endl; return 1;}
+    }
+
+    mkdir(BENCH_PATH, 0755);
+    map<string, BenchResult> baseline = loadResults(BENCH_PATH "baseline.json");
+
+    vector<BenchResult> results;
+    for (auto& model : BENCH_MODELS)
+        for (auto& scheduler : BENCH_SCHEDULERS)
+            for (auto batch : BENCH_BATCHES)
+                for (auto pages : BENCH_VRAM_PAGES)
+                {
+                    BenchResult result;
+                    result.name = model + "_" + scheduler + "_B" + to_string(batch) + "_" + to_string(pages) + "Pages";
+                    result.args = {"--sm-num", BENCH_SM_NUM, "--vram-pages", to_string(pages), "-S", scheduler
+                                 , "-T", model, to_string(batch), "0", "-1", "100"};
+                    if (result.name.find(filter) != string::npos) results.push_back(result);
+                }
+
+    cout << left << setw(36) << "Case" << right << setw(12) << "Cycles" << setw(12) << "Wall(ms)" << setw(12) << "Compile(ms)"
+         << setw(12) << "Sim(ms)" << setw(14) << "Cycles/s" << setw(12) << "RSS(MB)" << setw(10) << "Diff" << endl;
+
+    bool regression = false;
+    for (auto& result : results)
+    {
+        runCase(result, timeout);
+
+        string diff = "";
+        auto it = baseline.find(result.name);
+        if (!result.finished) diff = "FAILED";
+        else if (it != baseline.end() && it->second.finished)
+        {
+            double change = result.throughput() / it->second.throughput() - 1;
+            stringstream buff;
+            buff << showpos << fixed << setprecision(1) << change * 100 << "%";
+            diff = buff.str();
+
+            /* The simulated cycles change means the result of the simulation changes */
+            if (result.cycles != it->second.cycles) diff += " CHANGED";
+            if (change < -BENCH_TOLERANCE)
+            {
+                diff += " REGRESSION";
+                regression = true;
+            }
+        }
+
+        cout << left << setw(36) << result.name << right << fixed << setprecision(1) << setw(12) << result.cycles
+             << setw(12) << result.wall_ms << setw(12) << result.compile_ms << setw(12) << result.run_ms - result.compile_ms
+             << setw(14) << setprecision(0) << result.throughput() << setw(12) << setprecision(1) << result.peak_rss_kb / 1024.0
+             << "  " << diff << endl;
+    }
+
+    saveResults(BENCH_PATH "result.json", results);
+    if (update) saveResults(BENCH_PATH "baseline.json", results);
+
+    cout << "Result: " << BENCH_PATH "result.json" << (update ? ", saved as the baseline" : "") << endl;
+    return regression ? 1 : 0;
+}
+
+
+/** ===============================================================================================
+ * \name    runCase
+ *
+ * \brief   Run the simulator of the case and collect its measurement
+ *
+ * \param   result      the case, filled with the measurement
+ * \param   timeout     kill the simulator after the seconds, 0 for no limit
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void runCase (BenchResult& result, int timeout)
+{
+    string stats_path = BENCH_PATH + result.name + ".stats";
+    unlink(stats_path.c_str());
+
+    vector<string> args = result.args;
+    args.insert(args.begin(), SIMULATOR);
+    args.insert(args.end(), {"--stats", stats_path});
+
+    auto start = chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        int null_fd = open("/dev/null", O_WRONLY);
+        dup2(null_fd, STDOUT_FILENO);
+
+        vector<char*> argv;
+        for (auto& arg : args) argv.push_back((char*)arg.c_str());
+        argv.push_back(nullptr);
+
+        execv(SIMULATOR, argv.data());
+        _exit(127);
+    }
+    if (pid < 0) return;
+
+    int status = 0;
+    struct rusage usage;
+    while (wait4(pid, &status, WNOHANG, &usage) == 0)
+    {
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (timeout && elapsed > timeout) kill(pid, SIGKILL);
+        usleep(10000);
+    }
+    result.wall_ms     = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    result.peak_rss_kb = usage.ru_maxrss;
+
+    /* The last line of the statistic file is the final snapshot */
+    ifstream file(stats_path);
+    string line, last;
+    while (getline(file, line)) if (!line.empty()) last = line;
+
+    double cycles = 0, compile_us = 0, run_us = 0;
+    result.finished = WIFEXITED(status) && WEXITSTATUS(status) == 0 && last.find("\"final\":true") != string::npos
+                   && readValue(last, "cycle", cycles) && readValue(last, "host.compile_time", compile_us) && readValue(last, "host.run_time", run_us);
+
+    result.cycles     = cycles;
+    result.compile_ms = compile_us / 1000;
+    result.run_ms     = run_us / 1000;
+}
+
+
+/** ===============================================================================================
+ * \name    readValue
+ *
+ * \brief   Read the number of the key in the JSON line
+ *
+ * \endcond
+ * ================================================================================================
+ */
+bool readValue (const string& text, const string& key, double& value)
+{
+    auto pos = text.find("\"" + key + "\":");
+    if (pos == string::npos) return false;
+
+    value = atof(text.c_str() + pos + key.size() + 3);
+    return true;
+}
+
+
+/** ===============================================================================================
+ * \name    loadResults / saveResults
+ *
+ * \brief   The result file has one case per line, so it is read back without a JSON parser
+ *
+ * \endcond
+ * ================================================================================================
+ */
+map<string, BenchResult> loadResults (const string& path)
+{
+    map<string, BenchResult> results;
+
+    ifstream file(path);
+    string line;
+    while (getline(file, line))
+    {
+        auto pos = line.find("\"name\":\"");
+        if (pos == string::npos) continue;
+
+        BenchResult result;
+        result.name = line.substr(pos + 8, line.find('"', pos + 8) - pos - 8);
+
+        double cycles = 0, wall_ms = 0;
+        result.finished = line.find("\"finished\":true") != string::npos && readValue(line, "cycles", cycles) && readValue(line, "wall_ms", wall_ms);
+        result.cycles   = cycles;
+        result.wall_ms  = wall_ms;
+        results[result.name] = result;
+    }
+
+    return results;
+}
+
+void saveResults (const string& path, const vector<BenchResult>& results)
+{
+    ofstream file(path, ios::out | ios::trunc);
+    file << fixed << setprecision(3) << "{\"cases\":[" << endl;
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        auto& result = results[i];
+        string args;
+        for (auto& arg : result.args) args += (args.empty() ? "" : " ") + arg;
+
+        file << "{\"name\":\"" << result.name << "\",\"args\":\"" << args << "\",\"finished\":" << (result.finished ? "true" : "false")
+             << ",\"cycles\":" << result.cycles << ",\"wall_ms\":" << result.wall_ms << ",\"compile_ms\":" << result.compile_ms
+             << ",\"simulate_ms\":" << result.run_ms - result.compile_ms << ",\"cycles_per_second\":" << result.throughput()
+             << ",\"peak_rss_kb\":" << result.peak_rss_kb << "}" << (i + 1 < results.size() ? "," : "") << endl;
+    }
+    file << "]}" << endl;
+}
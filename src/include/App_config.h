@@ -23,6 +23,8 @@
 #include <list>
 #include <queue>
 #include <map>
+#include <set>
+#include <sstream>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -33,6 +35,8 @@
 #include <sys/time.h>
 
 #include "Global.h"
+#include "HardwareConfig.h"
+#include "SimContext.h"
 #include "Macro.h"
 
 /* ************************************************************************************************
@@ -66,6 +70,9 @@ class Block;
 class Kernel;
 class Request;
 
+class TraceRecorder;
+class TraceReplayer;
+
 
 /* ************************************************************************************************
  * Enumeration
@@ -78,11 +85,13 @@ class Request;
  */
 #define LOG_LEVEL                           WARNNING
 #define LOG_OUT_PATH                        "./log/"
+#define LOG_BUFFER_SIZE                     (4 << 20)                   // unit (Byte), the ring buffer of the log writer
 #define PRINT_TIME_STEP                     false
 #define PRINT_SM_ALLCOATION_RESULT          true
 #define PRINT_MODEL_DETIAL                  true
 #define PRINT_MEMORY_ALLOCATION             false
 #define PRINT_DEMAND_PAGE_RECORD            false
+#define PRINT_CGROUP_RECORD                 true
 #define PRINT_BLOCK_RECORD                  false
 #define PRINT_WARP_RECORD                   false
 
@@ -97,7 +106,10 @@ class Request;
 #define ENABLE_DEADLINE                     false
 #define DEADLINE_PERCENTAGE                 100                     // unit (ms)
 
-#define HARDWARE_ARCHITECTURE               AGX_XAVIER
+#define HARDWARE_ARCHITECTURE               AGX_XAVIER             // default hardware profile, AGX_XAVIER | AGX_ORIN | A100
+#define MODEL_PATH                          "./models/"            // the model description for -T name is MODEL_PATH/name.net
+#define PROFILE_PATH                        "./profile/"           // the cached model profiles
+#define HARD_DEADLINE                       false                  // drop the model which cannot meet the deadline, needs the profiled execute time
 
 /* ************************************************************************************************
  * Software Configuration
@@ -108,6 +120,7 @@ class Request;
 #define ENABLE_PAGE_FAULT_PENALTY           true
 #define COMPULSORY_MISS                     true                                                            // Initial the data in the DRAM ? (deprecated)
 #define PAGE_PREFETCH                       false
+#define ENABLE_DIRTY_TRACKING               true                                                            // Only the dirty evicted page is written back to the DRAM
 
 #define ENABLE_THREAD_COMPILE               true
 
@@ -115,67 +128,119 @@ class Request;
  * Hardware Configuration
  * ************************************************************************************************
  */
-#if (HARDWARE_ARCHITECTURE == AGX_XAVIER)
-    /* Architecture */
-    #define PAGE_SIZE                       4096                    // unit (Byte)
-    #define PRE_ALLOCATE_SIZE               256   * pow(2, 20)      // unit (Byte)  256 MB
-    #define PCIE_BANDWIDTH                  16    * pow(10, 9)      // unit (B/s)  16 GB/s
-
-    /* Frequency */ 
-    #define CPU_F                           1200000000.0            // unit (Hz)    1200 MHz
-    #define MC_F                            4266000000.0            // unit (Hz)    4266 MHz
-    #define GPU_F                           1377000000.0            // unit (Hz)    1377 MHz
-    #define GMMU_F                          1377000000.0            // unit (Hz)    1377 MHz
-
-    /* CPU */   
-    #define CPU_CONSTANT_POWER	            1526  * pow(0.1, 3)     // unit (W) (8 core, Frequence=1200000000)
-
-    /* DRAM */ 
-    #define DRAM_CAHNNEL_BANDWIDTH          32
-    #define DRAM_TOTAL_BANDWIDTH            256
-    #define DRAM_READ_LATENCY	            10    * pow(0.1, 10)	// unit (s) about 30GB/s
-    #define DRAM_WRITE_LATENCY	            10    * pow(0.1, 10)	// unit (s) about 30GB/s
-    #define DRAM_READ_ENENGY	            2.3   * pow(0.1, 9)	    // unit (J)
-    #define DRAM_WRITE_ENENGY	            2.44  * pow(0.1, 9)	    // unit (J)
-    #define DRAM_LEAKAGE_POWER	            70.8  * pow(0.1, 3)	    // unit (W)
-
-    /* GPU */   
-    #define GPU_MAX_WARP_PER_SM             32 
-    #define GPU_MAX_WARP_PER_BLOCK          32 
-    #define GPU_MAX_THREAD_PER_WARP         32 
-    #define GPU_MAX_THREAD_PER_SM           GPU_MAX_THREAD_PER_WARP * GPU_MAX_THREAD_PER_WARP
-    #define GPU_MAX_BLOCK_PER_SM            32
-    #define GPU_MAX_THREAD_PER_BLOCK        1024
-    #define GPU_MAX_ACCESS_NUMBER           32 
-    #define GPU_REGISTER_PER_SM             65536 
-
-    #define GPU_SHARED_MEMORY_PER_SM        96    * pow(2, 10) 	    // unit (KB)
-    #define GPU_L1_CACHE_SIZE               48    * 1024            // unit (B)
-    #define GPU_L1_CACHE_LINE_SIZE          32                      // unit (B)
-    #define GPU_L1_CACHE_WAY_NUMBER         4                       // unit (B)
-    #define GPU_L1_CACHE_BLOCK_SIZE         GPU_L1_CACHE_LINE_SIZE * GPU_L1_CACHE_WAY_NUMBER  // unit (B)
-
-    #define GPU_L2_CACHE_SIZE               4     * 1024 * 1024     // unit (B)
-    #define GPU_L2_CACHE_LINE_SIZE          32                      // unit (B)
-    #define GPU_L2_CACHE_WAY_NUMBER         16                      // unit (B)
-    #define GPU_L2_CACHE_BLOCK_SIZE         GPU_L1_CACHE_LINE_SIZE * GPU_L1_CACHE_WAY_NUMBER  // unit (B)
-    #define GPU_VRAM_SIZE                   
-
-    #define GPU_IDEL_POWER		            10    * pow(0.1, 3)     // unit (W) (Frequence=1377000000)
-    #define GPU_EXEC_POWER		            19326 * pow(0.1, 3)     // unit (W) (Frequence=1377000000)
-#endif
+/* The parameters are read from hardware_config, which is HARDWARE_ARCHITECTURE by default and can be
+ * replaced at runtime by --hw-profile */
+/* Architecture */
+#define PAGE_SIZE                           (hardware_config.page_size)                 // unit (Byte)
+#define PRE_ALLOCATE_SIZE                   (hardware_config.pre_allocate_size)         // unit (Byte)
+#define PCIE_BANDWIDTH                      (hardware_config.pcie_bandwidth)            // unit (B/s)
+#define PEER_BANDWIDTH                      (hardware_config.peer_bandwidth)            // unit (B/s)
+
+/* Frequency */ 
+#define CPU_F                               (hardware_config.cpu_f)                     // unit (Hz)
+#define MC_F                                (hardware_config.mc_f)                      // unit (Hz)
+#define GPU_F                               (hardware_config.gpu_f)                     // unit (Hz)
+#define GMMU_F                              (hardware_config.gmmu_f)                    // unit (Hz)
+
+/* CPU */   
+#define CPU_CONSTANT_POWER                  (hardware_config.cpu_constant_power)        // unit (W)
+
+/* DRAM */ 
+#define DRAM_CAHNNEL_BANDWIDTH              (hardware_config.dram_channel_bandwidth)
+#define DRAM_TOTAL_BANDWIDTH                (hardware_config.dram_total_bandwidth)
+#define DRAM_READ_LATENCY                   (hardware_config.dram_read_latency)         // unit (s)
+#define DRAM_WRITE_LATENCY                  (hardware_config.dram_write_latency)        // unit (s)
+#define DRAM_READ_ENENGY                    (hardware_config.dram_read_energy)          // unit (J)
+#define DRAM_WRITE_ENENGY                   (hardware_config.dram_write_energy)         // unit (J)
+#define DRAM_LEAKAGE_POWER                  (hardware_config.dram_leakage_power)        // unit (W)
+
+/* GPU */   
+#define GPU_MAX_WARP_PER_SM                 (hardware_config.max_warp_per_sm)
+#define GPU_MAX_WARP_PER_BLOCK              (hardware_config.max_warp_per_block)
+#define GPU_MAX_THREAD_PER_WARP             (hardware_config.max_thread_per_warp)
+#define GPU_MAX_THREAD_PER_SM               (GPU_MAX_WARP_PER_SM * GPU_MAX_THREAD_PER_WARP)
+#define GPU_MAX_BLOCK_PER_SM                (hardware_config.max_block_per_sm)
+#define GPU_MAX_THREAD_PER_BLOCK            (hardware_config.max_thread_per_block)
+#define GPU_MAX_ACCESS_NUMBER               (hardware_config.max_access_number)
+#define GPU_REGISTER_PER_SM                 (hardware_config.register_per_sm)
+
+#define GPU_SHARED_MEMORY_PER_SM            (hardware_config.shared_memory_per_sm)      // unit (B)
+#define GPU_L1_CACHE_SIZE                   (hardware_config.l1_cache_size)             // unit (B)
+#define GPU_L1_CACHE_LINE_SIZE              (hardware_config.l1_cache_line_size)        // unit (B)
+#define GPU_L1_CACHE_WAY_NUMBER             (hardware_config.l1_cache_way_number)
+#define GPU_L1_CACHE_BLOCK_SIZE             GPU_L1_CACHE_LINE_SIZE * GPU_L1_CACHE_WAY_NUMBER  // unit (B)
+
+#define GPU_L2_CACHE_SIZE                   (hardware_config.l2_cache_size)             // unit (B)
+#define GPU_L2_CACHE_LINE_SIZE              (hardware_config.l2_cache_line_size)        // unit (B)
+#define GPU_L2_CACHE_WAY_NUMBER             (hardware_config.l2_cache_way_number)
+#define GPU_L2_CACHE_BLOCK_SIZE             GPU_L1_CACHE_LINE_SIZE * GPU_L1_CACHE_WAY_NUMBER  // unit (B)
+
+#define GPU_IDEL_POWER                      (hardware_config.gpu_idle_power)            // unit (W)
+#define GPU_EXEC_POWER                      (hardware_config.gpu_exec_power)            // unit (W)
+
+#define GPU_WARP_SCHEDULER_PER_SM           (hardware_config.warp_scheduler_per_sm)
+#define GPU_ISSUE_WIDTH                     (hardware_config.issue_width)               // unit (warp/cycle)
+#define TWO_LEVEL_ACTIVE_WARP               8                                           // unit (warp), the active set of each two-level warp scheduler
+
 
+/* ************************************************************************************************
+ * Occupancy Configuration (enabled by --occupancy)
+ * ************************************************************************************************
+ */
+#define OCCUPANCY_BLOCK_THREAD              256                                                             // unit (thread), capped by GPU_MAX_THREAD_PER_BLOCK
+#define OCCUPANCY_MAX_SHARED_MEMORY         (48 * 1024)                                                     // unit (B), the static shared memory of a block
+
+/* ************************************************************************************************
+ * Dynamic Dispatch Configuration (enabled by --dispatch dynamic)
+ * ************************************************************************************************
+ */
+#define DYNAMIC_BLOCK_ROUND                 1                                                               // unit (round), the requests of a logical block per thread
+
+/* ************************************************************************************************
+ * Stream Configuration (enabled by --hw-queues and --stream-priority)
+ * ************************************************************************************************
+ */
+#define STREAM_PRIORITY_LEVEL               4                                                               // the priority levels of the streams, 0 (default) to 3 (highest)
 
 /* ************************************************************************************************
  * Page Fault Configuration
  * ************************************************************************************************
  */
-#define PAGE_FAULT_PENALTY                  20 * pow(0.1, 6)                                                // unit (s)
+#define PAGE_FAULT_PENALTY                  (hardware_config.page_fault_penalty)                            // unit (s)
 #define PAGE_FAULT_COMMUNICATION_CYCLE      (PAGE_FAULT_PENALTY) * (GMMU_F)                                 // unit (cycle)
 #define PAGE_FAULT_MIGRATION_UNIT_CYCLE     ceil((PAGE_SIZE) / (PCIE_BANDWIDTH) * (GMMU_F))                 // unit (cycle)
 #define MSHR_STACK_SIZE                     1024                                                            // unit (pages)
+#define CLEAN_VICTIM_SCAN_WINDOW            0                                                               // unit (pages), LRU pages scanned for a clean victim
 #define PCIE_ACCESS_BOUND                   80                                                              // unit (pages), ~= PAGE_FAULT_PENALTY / (PAGE_SIZE / PCIE_BANDWIDTH)
 
+/* ************************************************************************************************
+ * Peer Link Configuration (enabled by --peer-link with --gpu-num)
+ * ************************************************************************************************
+ */
+#define PEER_MIGRATION_UNIT_CYCLE           ceil((PAGE_SIZE) / (PEER_BANDWIDTH) * (GMMU_F))                 // unit (cycle)
+#define PEER_CGROUP                         -2                                                              // the CGroup key of the pages evicted from the peers
+
+/* ************************************************************************************************
+ * Remote Access Configuration (zero-copy, enabled by --access-counter)
+ * ************************************************************************************************
+ */
+#define REMOTE_ACCESS_LATENCY               (hardware_config.remote_access_latency)                         // unit (s)
+#define REMOTE_ACCESS_CYCLE                 (REMOTE_ACCESS_LATENCY) * (GMMU_F)                              // unit (cycle)
+#define REMOTE_ACCESS_UNIT_CYCLE            ceil((GPU_L1_CACHE_LINE_SIZE) / (PCIE_BANDWIDTH) * (GMMU_F))    // unit (cycle), one cache line per page over PCIe
+
+/* ************************************************************************************************
+ * Analytic Fidelity Configuration (enabled by --fidelity analytic), calibrated against cycle mode
+ * ************************************************************************************************
+ */
+#define ANALYTIC_ACCESS_CYCLE               4                                                               // unit (cycle), round trip of a resident access from warp to MC
+
+/* ************************************************************************************************
+ * Kernel Memoization Configuration (enabled by --memo)
+ * ************************************************************************************************
+ */
+#define MEMO_RESIDENT_BUCKET                10                                                              // the resident fraction of the kernel pages is keyed by n levels
+#define MEMO_VERIFY_INTERVAL                10                                                              // the strict mode simulates the 1st, (n+1)-th ... replay of a record
+
 /* ************************************************************************************************
  * Other Flags
  * ************************************************************************************************
@@ -77,10 +77,6 @@ public:
     /* Running Models */
     list<Model*> waitingModels = {};
     list<Model*> runningModels = {};
-
-private:
-    /* Number of layer be created */
-    static int appCount;
 };
 
 #endif
\ No newline at end of file
@@ -35,7 +35,7 @@ class Block
  */ 
 public:
 
-    Block(Kernel* kernel) : blockID(blockCount++), runningKernel(kernel) {}
+    Block(Kernel* kernel) : blockID(sim_context->block_count++), runningKernel(kernel) {}
 
    ~Block() {}
 
@@ -66,15 +66,14 @@ public:
 
     BlockRecord record;
 
+    /* Taken from the SM until the block finishes */
+    BlockResource resource;
+
     list<Warp*> warps;
 
 	Kernel* runningKernel = nullptr;
 
     queue<Request*> requests;
-
-private:
-    /* Number of block be created */
-    static int blockCount;
 };
 
 
@@ -41,7 +41,7 @@ class CPU
  */ 
 public:
 
-    CPU(MemoryController* mc, GPU* gpu);
+    CPU(MemoryController* mc, GPU* gpu, const vector<Application*>& apps);
 
    ~CPU();
 
@@ -52,6 +52,8 @@ public:
 public:
     void cycle ();
     bool Check_All_Applications_Finish();
+    unsigned long long nextEventCycle ();
+    Application* getApplication (int app_id);
 
 private:
     bool Check_Finish_Kernel ();
@@ -21,6 +21,17 @@
 #include "MemoryController.hpp"
 #include "TLB.hpp"
 
+/* ************************************************************************************************
+ * Type Define
+ * ************************************************************************************************
+ */
+/* The transfer out of VRAM caused by inserting a page */
+typedef enum {
+    EVICT_NONE,                 // no eviction, or the clean page is dropped
+    EVICT_WRITEBACK,            // the dirty page is written back to the host over PCIe
+    EVICT_PEER,                 // the page is moved into the idle VRAM of a peer over the peer link
+} Eviction;
+
 /** ===============================================================================================
  * \name    GMMU
  * 
@@ -37,7 +48,7 @@ class GMMU
  */ 
 public:
 
-    GMMU(GPU* gpu, MemoryController* mc);
+    GMMU(GPU* gpu, MemoryController* mc, int gpu_id = 0);
 
    ~GMMU();
 
@@ -50,41 +61,119 @@ public:
 
     bool terminateModel (int app_id, int model_id);
 
-    void setCGroupType (bool isolation) { MEMORY_ISOLATION = isolation; }
-    void setCGroupSize (int app_id, unsigned long long capacity);
+    void prefetch (int app_id, const vector<unsigned long long>& page_list, int priority = 0);
+    pair<unsigned long long, unsigned long long> migratePages (int app_id, const vector<unsigned long long>& page_list);
+
+    bool isIdle ();
+    unsigned long long getFaultHandlerCycle () {return fault_handler_cycle;}
+
+    void issueAccess (MemoryAccess* access);
+    void setTraceReplayer (TraceReplayer* replayer) {mReplayer = replayer;}
+
+    void setCGroupType (bool isolation);
+    void setCGroupSize (int app_id, unsigned long long capacity, unsigned long long limit = -1);
     void freeCGroup (int app_id);
     LRU_TLB<unsigned long long, Page*>* getCGroup (int model_id);
+    unsigned long long getCGroupTarget (int app_id);
+    unsigned long long getCGroupCapacity (int app_id);
+
+    void printCGroupRecord ();
+
+    void setPeers (const vector<GMMU*>& peers) {mPeers = peers;}
+    unsigned long long getIdlePages ();
+    pair<unsigned long long, unsigned long long> getPeerRecord () {return {peer_evict_count, peer_fetch_count};}
 
 private:
     void Access_Processing ();
     void Page_Fault_Handler ();
+    bool Remote_Access (MemoryAccess* access);
+    void Fault_Merging (MemoryAccess* access);
+
+    Eviction evictPage (Page* page, bool to_peer = true);
+    Eviction insertPage (int app_id, Page* page);
+
+    bool acceptPeerPage (Page* page);
+    bool takePeerPage (unsigned long long page_id);
+    void releasePeerPages ();
+    double migrationCycle ();
     
 /* ************************************************************************************************
  * Parameter
  * ************************************************************************************************
  */
+public:
+    const int gpuID;
+
 private:
 
     GPU* mGPU;
     MemoryController* mMC;
+    MemoryChannel* mChannel;
+
+    /* The GMMUs of the other GPUs over the peer link, empty without --peer-link */
+    vector<GMMU*> mPeers;
+    unsigned long long peer_evict_count = 0, peer_fetch_count = 0;
 
-    list<MemoryAccess*> MSHRs;
+    /* The accesses are issued by the trace instead of the SMs, see --trace-replay */
+    TraceReplayer* mReplayer = nullptr;
 
 	list<MemoryAccess*> warps_to_gmmu_queue;
 	list<MemoryAccess*> gmmu_to_warps_queue;
     
+    /* *******************************************************************
+     * \param app_id        the application demanding the page
+     * \param prefetch      the entry is issued by prefetch
+     * \param waiters       the accesses waiting for the page
+     * *******************************************************************
+     */
+    struct MSHR_Entry {
+        int app_id;
+        bool prefetch;
+        list<MemoryAccess*> waiters;
+    };
+
+    /* MSHR, the fault page to its waiters */
+    unordered_map<unsigned long long, MSHR_Entry> mMSHR;
+    list<unsigned long long> pending_pages;
+
     /* Page Fault handler */
 	long long wait_cycle = 0;
-    map<MemoryAccess*, int> access_count;
-    list<pair<unsigned long long, list<MemoryAccess*>>> page_fault_process_queue;
+    /* The cycles the page fault handler is busy with the demanded pages */
+    unsigned long long fault_handler_cycle = 0;
+    list<unsigned long long> page_fault_process_queue;
+    list<Page*> pinned_pages;
+    /* The issue cycle and the demanded pages of the running fault batch */
+    unsigned long long fault_batch_cycle = 0, fault_batch_pages = 0;
+
+    /* Prefetch, key: priority (higher first), value: {app_id, page_id} */
+    map<int, list<pair<int, unsigned long long>>, greater<int>> prefetch_queue;
+    list<unsigned long long> prefetch_process_queue;
+
+    /* Remote access (zero-copy) over PCIe, first: the finish cycle */
+    unsigned long long gmmu_cycle = 0;
+    unsigned long long pcie_free_cycle = 0;
+    list<pair<unsigned long long, MemoryAccess*>> remote_access_queue;
 
     /* *******************************************************************
      * \param model_id      the cgroup is isolated in each model
      * \param cgroup        the cgroup, use LRU
+     * \param record        the soft target, hard limit and statistic of cgroup
      * *******************************************************************
      */
+    struct CGroupRecord {
+        /* The budget given by scheduler, the pages over target are reclaimed first */
+        unsigned long long target = 0;
+        /* The cgroup can borrow the idle pages up to the limit */
+        unsigned long long limit  = system_resource.VRAM_SPACE / PAGE_SIZE;
+
+        unsigned long long borrow_count  = 0;
+        unsigned long long reclaim_count = 0;
+        unsigned long long evict_count   = 0;
+    };
+
     bool MEMORY_ISOLATION = false;
 	map<int, LRU_TLB<unsigned long long, Page*>> mCGroups;
+	map<int, CGroupRecord> mCGroupRecords;
 
 friend SM;
 };
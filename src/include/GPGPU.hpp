@@ -5,6 +5,8 @@
  * 
  * \note    It's a simulator for simulating the behavior of a GPGPU (General Porpose GPU).
  * 
+ * \note    The node has command.GPU_NUM GPUs sharing the host memory controller, see NodeScheduler.hpp
+ * 
  * \date    APR 18, 2023
  */
 
@@ -21,6 +23,10 @@
 
 #include "CPU.hpp"
 #include "MemoryController.hpp"
+#include "NodeScheduler.hpp"
+#include "Trace.hpp"
+#include "Timeline.hpp"
+#include "Statistics.hpp"
 
 /* ************************************************************************************************
  * Declaration
@@ -64,15 +70,24 @@ public:
 
     int next_clock_domain();
 
+private:
+    void skip_idle_cycles();
+    void printNodeRecord();
+
 /* ************************************************************************************************
  * Module
  * ************************************************************************************************
  */
 private:
     MemoryController mMC;
-    CPU mCPU;
-    GPU mGPU;
-    GMMU* mGMMU;
+    NodeScheduler mNode;
+
+    /* The GPUs of the node, each is driven by its own CPU scheduler */
+    vector<GPU*> mGPUs;
+    vector<CPU*> mCPUs;
+
+    /* The front end of --trace-replay instead of the CPU and the SMs */
+    TraceReplayer* mReplayer = nullptr;
 
 /* ************************************************************************************************
  * Parameter
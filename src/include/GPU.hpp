@@ -74,7 +74,7 @@ class GPU
  */ 
 public:
 
-    GPU(MemoryController* mc);
+    GPU(MemoryController* mc, int gpu_id = 0);
 
    ~GPU();
 
@@ -93,15 +93,33 @@ public:
     GMMU* getGMMU() {return &mGMMU;}
     unordered_set<int> getIdleSMs();
 
+    unsigned long long nextEventCycle ();
+    void printAnalyticRecord ();
+    void printMemoRecord ();
+
 private:
     void Runtime_Block_Scheduling();
     void Check_Finish_Kernel();
+    void Analytic_Kernel_Launch(Kernel* kernel);
+    int  Block_Split(map<int, int>& sm_blocks, int num_of_block);
+    void Incremental_Block_Dispatch(Kernel* kernel);
+    void Stream_Dependency(unordered_set<Kernel*>& blocked_kernels);
+    int  getStreamPriority(Kernel* kernel) const;
+    int  Sampled_Kernel_Split(Kernel* kernel, int division_count);
+    void Sampled_Kernel_Extrapolate(Kernel* kernel);
+    bool Memo_Kernel_Replay(Kernel* kernel);
+    void Memo_Kernel_Record(Kernel* kernel);
+    bool isSMIdle(int sm_id);
+    bool isSMReady(int sm_id, Kernel* kernel);
+    vector<unsigned long long> recordAccesses(const vector<Request*>& requests);
 
 /* ************************************************************************************************
  * Parameter
  * ************************************************************************************************
  */
 public:
+    const int gpuID;
+
     bool canIssueKernel;
 
     list<Kernel*>  commandQueue = {};
@@ -115,6 +133,98 @@ private:
 
     map<int, SM> mSMs;
 
+    /* *******************************************************************
+     * Analytic fidelity, the kernels hold their SMs until the estimated
+     * finish cycle. The memory controller and the page fault handler are
+     * shared, the kernels queue on them by their busy cycles.
+     * *******************************************************************
+     */
+    struct AnalyticRecord {
+        unsigned long long kernel_count = 0;
+        long double estimate_cycle = 0, lower_cycle = 0, upper_cycle = 0;
+        double max_lower_error = 0, max_upper_error = 0;
+    };
+
+    unordered_map<Kernel*, unsigned long long> analyticKernels;
+    unordered_set<int> analyticSMs;
+
+    unsigned long long mc_free_cycle = 0;
+    unsigned long long fault_free_cycle = 0;
+
+    AnalyticRecord analytic_record;
+
+    /* *******************************************************************
+     * Sampled fidelity, each block simulates its first requests in detail
+     * and the skipped requests are fast-forwarded once the sampled blocks
+     * finish, the kernel then holds its SMs as an analytic kernel
+     * *******************************************************************
+     */
+    struct SampleRecord {
+        vector<Request*> skipped_requests;
+        unsigned long long sampled_request = 0;
+        unsigned long long fault_page = 0;
+        unsigned long long start_cycle = 0;
+        unsigned long long start_fault_cycle = 0;
+    };
+
+    unordered_map<Kernel*, SampleRecord> sampledKernels;
+
+    /* *******************************************************************
+     * Incremental and dynamic dispatch, the running kernels with requests
+     * left bind their blocks to their SMs as the SMs admit them
+     * *******************************************************************
+     */
+    unordered_map<Kernel*, int> dispatchKernels;    // the requests of each block
+
+    /* *******************************************************************
+     * Streams, the queued kernels once blocked by a kernel of another
+     * stream on their hardware queue
+     * *******************************************************************
+     */
+    unordered_set<Kernel*> falseDependencies;
+
+    /* *******************************************************************
+     * Kernel memoization, the launch with the same layer, batch, SM
+     * number, resident fraction and co-runners replays the recorded
+     * duration and block records as an analytic kernel
+     * *******************************************************************
+     */
+    struct MemoKey {
+        size_t signature;
+        int batch_size;
+        int sm_count;
+        int resident_bucket;
+        vector<size_t> co_runners;
+
+        bool operator< (const MemoKey& other) const {
+            return tie(signature, batch_size, sm_count, resident_bucket, co_runners) 
+                 < tie(other.signature, other.batch_size, other.sm_count, other.resident_bucket, other.co_runners);
+        }
+    };
+
+    struct MemoEntry {
+        unsigned long long duration = 0;
+        unsigned long long replay_count = 0;
+        vector<int> sm_list;                        // the sorted SM_List, the replay maps the SMs by order
+        list<Block::BlockRecord> block_record;      // relative to the launch cycle
+    };
+
+    struct MemoLaunch {
+        MemoKey key;
+        unsigned long long launch_cycle;
+        bool verify;
+    };
+
+    struct MemoRecord {
+        unsigned long long hit_count = 0, miss_count = 0, verify_count = 0;
+        double max_verify_error = 0;
+    };
+
+    map<MemoKey, MemoEntry> memoTable;
+    unordered_map<Kernel*, MemoLaunch> memoKernels;
+
+    MemoRecord memo_record;
+
 friend GMMU;
 };
 
@@ -4,6 +4,8 @@
 
 #include <fstream>
 #include <list>
+#include <map>
+#include <string>
 
 /* ************************************************************************************************
  * Enumeration
@@ -31,12 +33,41 @@ typedef enum {
     DISABLE, MAX,
 }BATCH_METHOD;
 
+/* Simulation fidelity */
 typedef enum {
-    LeNet, CaffeNet, ResNet18, GoogleNet, VGG16, SqueezeNet,
-    ALL,
-    LIGHT, HEAVY, MIX,
-    TEST1, TEST2,
-}APPLICATION;
+	CYCLE,
+	ANALYTIC,
+	SAMPLED
+}FIDELITY;
+
+/* Kernel memoization */
+typedef enum {
+	NO_MEMO,
+	MEMO,
+	STRICT_MEMO
+}MEMOIZATION;
+
+/* Application placement on the GPUs of the node */
+typedef enum {
+	ROUND_ROBIN,
+	LEAST_LOAD,
+	LEAST_MEMORY
+}PLACEMENT;
+
+/* Warp scheduler of the SMs */
+typedef enum {
+	UNLIMITED_ISSUE,
+	GTO,
+	LRR,
+	TWO_LEVEL
+}WARP_SCHEDULER;
+
+/* Block dispatch of the kernels onto their SMs */
+typedef enum {
+	STATIC_DISPATCH,
+	INCREMENTAL_DISPATCH,
+	DYNAMIC_DISPATCH
+}DISPATCH;
 
 /* ************************************************************************************************
  * Type Define
@@ -62,12 +93,73 @@ struct RuntimeRecord
 	}
 };
 
+/* The resource of a block, the SM admits the blocks within its remaining resource */
+struct BlockResource
+{
+	int threads;
+	int registers;          // per thread
+	int shared_memory;      // unit (B)
+};
+
 struct Command {
     SCHEDULER    	SCHEDULER_MODE;
     BATCH_METHOD   	BATCH_MODE;
-    std::list<std::pair<APPLICATION, std::tuple<int /*batch_size*/, float /*arrival_time*/, float /*period*/, float /*deadline*/>>> TASK_LIST;
+    std::list<std::pair<std::string /*model name or model.net*/, std::tuple<int /*batch_size*/, float /*arrival_time*/, float /*period*/, float /*deadline*/>>> TASK_LIST;
+
+    /* Migrate the non-resident page after n remote accesses, 0 to always migrate on fault */
+    unsigned long   ACCESS_COUNTER_THRESHOLD;
+
+    /* Prefetch the filter of next kernel when launching kernel */
+    bool            PREFETCH_NEXT_KERNEL;
+
+    /* Profile the execute time of the models by an isolated simulation, always on with HARD_DEADLINE */
+    bool            PROFILE_EXECUTE_TIME;
+
+    /* Simulate the kernels cycle by cycle, or estimate their duration by the analytic model */
+    FIDELITY        FIDELITY_MODE;
+
+    /* The fraction of the requests of each block simulated in detail by the sampled fidelity */
+    float           SAMPLE_RATE;
+
+    /* Replay the recorded duration of the identical kernel launch, the strict mode verifies a sample of the replays */
+    MEMOIZATION     MEMO_MODE;
+
+    /* Record the accesses into the trace, or replay the trace on the GMMU without the SMs */
+    std::string     TRACE_RECORD_PATH;
+    std::string     TRACE_REPLAY_PATH;
 
-    Command() : SCHEDULER_MODE(Baseline), BATCH_MODE(MAX) {}
+    /* Write the timeline of the kernels, blocks and fault batches in the Chrome trace-event format */
+    std::string     TIMELINE_PATH;
+
+    /* Write the snapshot of the statistics every STATS_INTERVAL cycles and at the end, 0 for the end only */
+    std::string     STATS_PATH;
+    unsigned long long STATS_INTERVAL;
+
+    /* The GPUs of the node, each has SM_NUM SMs and VRAM_SPACE of VRAM, the applications are placed by PLACEMENT_MODE */
+    int             GPU_NUM;
+    PLACEMENT       PLACEMENT_MODE;
+
+    /* The GPUs evict the pages into the idle VRAM of their peers and fetch them back over the peer link */
+    bool            PEER_LINK;
+
+    /* Issue the warps by the warp schedulers of the hardware profile, or every ready warp in every cycle */
+    WARP_SCHEDULER  WARP_SCHEDULER_MODE;
+
+    /* Size the blocks by the resource of their layers and pack the blocks of different kernels into the SMs */
+    bool            OCCUPANCY;
+
+    /* Launch the kernel once all its SMs admit it, or bind its blocks (or its small logical blocks) to its SMs as they admit them */
+    DISPATCH        DISPATCH_MODE;
+
+    /* The stream of each application is mapped onto the hardware queue (appID % HW_QUEUE_NUM), 0 for the flat command queue */
+    int             HW_QUEUE_NUM;
+
+    /* The priority level of the stream of each application, key: appID, the higher level dispatches its blocks first */
+    std::map<int, int> STREAM_PRIORITY;
+
+    Command() : SCHEDULER_MODE(Baseline), BATCH_MODE(MAX), ACCESS_COUNTER_THRESHOLD(0), PREFETCH_NEXT_KERNEL(false), PROFILE_EXECUTE_TIME(false)
+              , FIDELITY_MODE(CYCLE), SAMPLE_RATE(0.1), MEMO_MODE(NO_MEMO), STATS_INTERVAL(0), GPU_NUM(1), PLACEMENT_MODE(ROUND_ROBIN), PEER_LINK(false)
+              , WARP_SCHEDULER_MODE(UNLIMITED_ISSUE), OCCUPANCY(false), DISPATCH_MODE(STATIC_DISPATCH), HW_QUEUE_NUM(0) {}
 };
 
 struct Resource {
@@ -79,21 +171,4 @@ struct Resource {
     Resource() : SM_NUM(8), DRAM_SPACE((unsigned long long) 32 * 1024 * 1024 * 1024), VRAM_SPACE(-1), DEADLINE_CYCLE(-1) {}
 };
 
-/* ************************************************************************************************
- * Global variable
- * ************************************************************************************************
- */
-/* Statistic */
-extern unsigned long long total_gpu_cycle;
-
-/* Thread Protect */
-extern pthread_mutex_t* ioMutex;
-
-/* Command */
-extern Command command;
-
-extern Resource	system_resource;
-
-extern std::string program_name;
-
 #endif
\ No newline at end of file
@@ -0,0 +1,122 @@
+/**
+ * \name    HardwareConfig.h
+ *
+ * \brief   Declare the hardware profile, the builtin profiles are compiled as constexpr and the
+ *          runtime profile can be loaded from file by --hw-profile
+ *
+ * \date    Oct 18, 2026
+ */
+
+#ifndef _HARDWARE_CONFIG_H_
+#define _HARDWARE_CONFIG_H_
+
+#include <string>
+
+/* ************************************************************************************************
+ * Type Define
+ * ************************************************************************************************
+ */
+struct HardwareConfig
+{
+    char name[32];
+
+    /* Architecture */
+    int    page_size;                   // unit (Byte)
+    double pre_allocate_size;           // unit (Byte)
+    double pcie_bandwidth;              // unit (B/s)
+    double peer_bandwidth;              // unit (B/s), the peer link between the GPUs of a node
+
+    /* Frequency */
+    double cpu_f;                       // unit (Hz)
+    double mc_f;                        // unit (Hz)
+    double gpu_f;                       // unit (Hz)
+    double gmmu_f;                      // unit (Hz)
+
+    /* CPU */
+    double cpu_constant_power;          // unit (W)
+
+    /* DRAM */
+    int    dram_channel_bandwidth;
+    int    dram_total_bandwidth;
+    double dram_read_latency;           // unit (s)
+    double dram_write_latency;          // unit (s)
+    double dram_read_energy;            // unit (J)
+    double dram_write_energy;           // unit (J)
+    double dram_leakage_power;          // unit (W)
+
+    /* GPU */
+    int    sm_num;
+    int    max_warp_per_sm;
+    int    max_warp_per_block;
+    int    max_thread_per_warp;
+    int    max_block_per_sm;
+    int    max_thread_per_block;
+    int    max_access_number;
+    int    register_per_sm;
+    double shared_memory_per_sm;        // unit (B)
+    int    l1_cache_size;               // unit (B)
+    int    l1_cache_line_size;          // unit (B)
+    int    l1_cache_way_number;
+    int    l2_cache_size;               // unit (B)
+    int    l2_cache_line_size;          // unit (B)
+    int    l2_cache_way_number;
+    double gpu_idle_power;              // unit (W)
+    double gpu_exec_power;              // unit (W)
+    int    warp_scheduler_per_sm;       // the warp schedulers of each SM, used by --warp-scheduler
+    int    issue_width;                 // unit (warp/cycle), the warps issued by each warp scheduler
+
+    /* Page Fault */
+    double page_fault_penalty;          // unit (s)
+    double remote_access_latency;       // unit (s)
+};
+
+/* ************************************************************************************************
+ * Builtin Profile
+ * ************************************************************************************************
+ */
+constexpr HardwareConfig AGX_XAVIER = {
+    "Xavier",
+    /* Architecture */  4096, 256 * 1048576.0, 16e9, 50e9,
+    /* Frequency */     1200000000.0, 4266000000.0, 1377000000.0, 1377000000.0,
+    /* CPU */           1.526,
+    /* DRAM */          32, 256, 1e-9, 1e-9, 2.3e-9, 2.44e-9, 70.8e-3,
+    /* GPU */           8, 32, 32, 32, 32, 1024, 32, 65536, 96 * 1024.0,
+                        48 * 1024, 32, 4, 4 * 1024 * 1024, 32, 16,
+                        10e-3, 19.326,
+                        4, 1,
+    /* Page Fault */    20e-6, 1e-6,
+};
+
+constexpr HardwareConfig AGX_ORIN = {
+    "Orin",
+    /* Architecture */  4096, 256 * 1048576.0, 16e9, 50e9,
+    /* Frequency */     2200000000.0, 6400000000.0, 1300000000.0, 1300000000.0,
+    /* CPU */           1.526,
+    /* DRAM */          32, 256, 1e-9, 1e-9, 2.3e-9, 2.44e-9, 70.8e-3,
+    /* GPU */           16, 48, 32, 32, 16, 1024, 32, 65536, 164 * 1024.0,
+                        128 * 1024, 32, 4, 4 * 1024 * 1024, 32, 16,
+                        10e-3, 40.0,
+                        4, 1,
+    /* Page Fault */    20e-6, 1e-6,
+};
+
+constexpr HardwareConfig A100 = {
+    "A100",
+    /* Architecture */  4096, 256 * 1048576.0, 32e9, 300e9,
+    /* Frequency */     2250000000.0, 2430000000.0, 1410000000.0, 1410000000.0,
+    /* CPU */           1.526,
+    /* DRAM */          32, 256, 1e-9, 1e-9, 2.3e-9, 2.44e-9, 70.8e-3,
+    /* GPU */           108, 64, 32, 32, 32, 1024, 32, 65536, 164 * 1024.0,
+                        192 * 1024, 32, 4, 40 * 1024 * 1024, 32, 16,
+                        50e-3, 400.0,
+                        4, 1,
+    /* Page Fault */    20e-6, 1e-6,
+};
+
+/* ************************************************************************************************
+ * Function
+ * ************************************************************************************************
+ */
+bool loadHardwareConfig (const std::string& profile);
+
+#endif
@@ -82,6 +82,10 @@ public:
     bool isRunning() {return running;}
     KernelInfo getKernelInfo() const {return kernelInfo;}
 
+    virtual size_t getSignature () const;
+    virtual int    getBatchSize () const {return 1;}
+    virtual BlockResource getBlockResource () const;
+
     void printInfo (bool title = false);
 
 /* ************************************************************************************************
@@ -117,10 +121,6 @@ public:
     queue<Request*> requests;
 
     vector<Kernel*> dependencyKernels; 
-
-private:
-    /* Number of kernel be created */
-    static int kernelCount;
 };
 
 
@@ -153,6 +153,10 @@ public:
     bool compileRequest (MMU* mmu) override;
     void handleKernelCompletion () override;
 
+    size_t getSignature () const override {return kernel_list.front().first->getSignature();}
+    int    getBatchSize () const override {return kernel_list.size();}
+    BlockResource getBlockResource () const override {return kernel_list.front().first->getBlockResource();}
+
 /* ************************************************************************************************
  * Parameter
  * ************************************************************************************************
@@ -103,6 +103,7 @@ protected:
      * \param   layer       the source layer pointer
      * \param   mmu         the memory management unit
      * \param   queue       the container to keep the compiled GPU requests
+     * \param   context     the simulation context of the compiling thread
      * 
      * \endcond
      * ******************************************************************
@@ -116,9 +117,11 @@ protected:
         Layer* srcLayer;
 
         queue<Request*>* requestQueue;
+
+        SimContext* context;
         
         ThreadArg(int thread_id, int num_thread, Layer* layer, MMU* mmu, queue<Request*>* queue) 
-            : threadID(thread_id), numThread(num_thread), srcLayer(layer), mmu(mmu), requestQueue(queue) {}
+            : threadID(thread_id), numThread(num_thread), srcLayer(layer), mmu(mmu), requestQueue(queue), context(sim_context) {}
     };
 
 /* ************************************************************************************************
@@ -133,6 +136,9 @@ public:
     virtual void memoryAllocate (MMU* mmu);
     PageRecord   memoryRelease  (MMU* mmu);
 
+    /* The resource of a block running the layer, by --occupancy */
+    virtual BlockResource getBlockResource () const;
+
     /* Make the kernel dependency by layer graph */
     virtual vector<Kernel*> compileToKernel (int app_id, int model_id, vector<Kernel>& container, vector<Kernel*> dependency);
 
@@ -186,8 +192,6 @@ public:
 
 protected:
 
-    static int vaCount;
-
     /* The dimensions of feature map and filter */
     vector<int> iFMapSize;     // In order "batch", "channel", "height", and "width"
     vector<int> oFMapSize;     // In order "batch", "channel", "height", and "width"
@@ -233,6 +237,7 @@ public:
     // void memoryAllocate(MMU* mmu) override;
     void printInfo() override;
     void issueLayer(ThreadArg* threadArg) override;
+    BlockResource getBlockResource() const override;
     
 private:
     void calculateOFMapSize() override;
@@ -275,6 +280,7 @@ public:
 public:
     void printInfo() override;
     void issueLayer(ThreadArg* threadArg) override;
+    BlockResource getBlockResource() const override;
     
 private:
     void calculateOFMapSize() override;
@@ -388,6 +394,7 @@ public:
 public:
     void printInfo() override;
     void issueLayer(ThreadArg* threadArg) override;
+    BlockResource getBlockResource() const override;
     
 private:
     void calculateOFMapSize() override;
@@ -95,4 +95,75 @@ inline void log_to_file (std::ofstream file, std::string logInfo){
     }
 }
 
+
+/** ===============================================================================================
+ * \name    LogWriter
+ *
+ * \brief   The writer of the log file (LOG_OUT_PATH + program_name + ".txt") of the simulation. The
+ *          lines are copied into a ring buffer and written by a background thread, so the call
+ *          sites do not open and close the file for every line.
+ *
+ * \note    Before open and after close, the lines are appended to the log file directly
+ *
+ * \endcond
+ * ================================================================================================
+ */
+class LogWriter
+{
+public:
+    static LogWriter& instance ();
+
+    void open  (const std::string& path);
+    void write (const std::string& text);
+    void flush ();
+    void close ();
+
+private:
+    LogWriter ();
+
+    static void* flushThread (void* arg);
+
+    static void prepareFork ();
+    static void parentFork ();
+    static void childFork ();
+
+private:
+    int fd = -1;
+    bool running = false, closing = false;
+
+    /* The bytes of [tail, head) are waiting in the ring, the positions are modulo the ring size */
+    std::vector<char> ring;
+    unsigned long long head = 0, tail = 0;
+
+    pthread_t flusher;
+    pthread_mutex_t mutex;
+    pthread_cond_t  data_cond, space_cond;
+};
+
+
+/** ===============================================================================================
+ * \name    LogStream
+ *
+ * \brief   Collect the lines like the ofstream of the log file, they are handed to the LogWriter
+ *          when the stream is closed or destroyed
+ *
+ * \endcond
+ * ================================================================================================
+ */
+class LogStream : public std::stringstream
+{
+public:
+   ~LogStream () {close();}
+
+    void close ()
+    {
+        if (closed) return;
+        LogWriter::instance().write(str());
+        closed = true;
+    }
+
+private:
+    bool closed = false;
+};
+
 #endif
\ No newline at end of file
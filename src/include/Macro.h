@@ -9,17 +9,19 @@
 #define ASSERT( ... )   GET_FUNCTION( __VA_ARGS__, ASSERT_2, ASSERT_1 ) (__VA_ARGS__)
 // #define DEBUG( ... )    GET_FUNCTION( __VA_ARGS__, DEBUG_2, DEBUG_1 )   (__VA_ARGS__)
 
+/* Write the message into the log and flush the log before exit, see Log.cpp */
+void log_fatal (const std::string& message);
+
 /* Assert function with print message */
 #define ASSERT_1( condition ) { if (!(condition)) exit (1); }
 #define ASSERT_2( condition, ... )                                             \
 {                                                                              \
     if (!(condition)) {                                                        \
-        std::cout << __FILE__  << ": " << __LINE__ << ": " <<  __func__        \
-                  << ": " << __VA_ARGS__ << std::endl;                         \
-        ofstream file(LOG_OUT_PATH + program_name + ".txt", std::ios::app);    \
-            file  << __FILE__  << ": " << __LINE__ << ": " <<  __func__        \
-                  << ": " << __VA_ARGS__ << std::endl;                         \
-        file.close();                                                          \
+        std::stringstream assert_buff;                                         \
+        assert_buff << __FILE__  << ": " << __LINE__ << ": " <<  __func__      \
+                    << ": " << __VA_ARGS__ << std::endl;                       \
+        std::cout << assert_buff.str();                                        \
+        log_fatal (assert_buff.str());                                         \
     exit (1);                                                                  \
     }                                                                          \
 }
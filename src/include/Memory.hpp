@@ -29,6 +29,7 @@ typedef enum {
 struct MemoryAccess {
     int app_id;
     int model_id;
+    int kernel_id;
 	int sm_id;
 	int block_id;
 	int warp_id;
@@ -38,8 +39,14 @@ struct MemoryAccess {
 
     vector<unsigned long long> pageIDs = {};
 
-    MemoryAccess(int app_id, int model_id, int sm_id, int block_id, int warp_id, int thread_id, int request_id, AccessType type) 
-            : app_id(app_id), model_id(model_id), sm_id(sm_id), block_id(block_id), warp_id(warp_id), thread_id(thread_id), request_id(request_id), type(type) {}
+    /* Number of pages waiting in GMMU's MSHR */
+    int outstanding = 0;
+
+    /* The cycle the GMMU receives the access */
+    unsigned long long issue_cycle = 0;
+
+    MemoryAccess(int app_id, int model_id, int kernel_id, int sm_id, int block_id, int warp_id, int thread_id, int request_id, AccessType type) 
+            : app_id(app_id), model_id(model_id), kernel_id(kernel_id), sm_id(sm_id), block_id(block_id), warp_id(warp_id), thread_id(thread_id), request_id(request_id), type(type) {}
 };
 
 /* All avaliable memory type */
@@ -121,11 +128,6 @@ public:
     const unsigned totalBandwidth;
     const unsigned channelBandwidth;
 
-private:
-    /* Number of memory be created */
-    static int memoryCount;
-    static unsigned long long storageCount;
-
 protected:
     /* Recorder */
     MemoryRecord recorder;
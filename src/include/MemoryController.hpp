@@ -28,6 +28,11 @@ struct PageRecord {
 
     unsigned long access_count = 0;
     unsigned long swap_count = 0;
+    unsigned long remote_count = 0;
+    unsigned long writeback_count = 0;
+
+    /* Access counter of the non-resident page, reset when the page is migrated */
+    unsigned long access_counter = 0;
 
     /* Operators */
     PageRecord operator+ (const PageRecord& other) const {
@@ -36,6 +41,8 @@ struct PageRecord {
             read_counter  + other.read_counter,
             access_count  + other.access_count,
             swap_count    + other.swap_count,
+            remote_count  + other.remote_count,
+            writeback_count + other.writeback_count,
         };
     }
 
@@ -44,17 +51,31 @@ struct PageRecord {
 		read_counter  += other.read_counter;
 		access_count  += other.access_count;
 		swap_count    += other.swap_count;
+		remote_count  += other.remote_count;
+		writeback_count += other.writeback_count;
 		return *this;
 	}
 };
 
+/* The VRAM channel of a GPU, serves the accesses hit in its VRAM */
+struct MemoryChannel {
+    list<MemoryAccess*> gmmu_to_mc_queue;
+    list<MemoryAccess*> mc_to_gmmu_queue;
+};
+
 struct Page {
     const unsigned long long pageIndex;
     Memory_t location;
     PageRecord record;
     Page* nextPage;
 
-    Page(unsigned long long page_index = 0, Memory_t location = SPACE_NONE, Page* next_page = nullptr) : pageIndex(page_index), location(location), nextPage(next_page) {}
+    /* The page is written since it's migrated into VRAM, need write back when evicted */
+    bool dirty;
+
+    /* The page is demanded by the processing page fault batch */
+    bool pinned;
+
+    Page(unsigned long long page_index = 0, Memory_t location = SPACE_NONE, Page* next_page = nullptr) : pageIndex(page_index), location(location), nextPage(next_page), dirty(false), pinned(false) {}
 };
 
 
@@ -73,7 +94,7 @@ class MemoryController
  * ************************************************************************************************
  */ 
 public:
-    MemoryController(unsigned long long storage_limit, int page_size);
+    MemoryController(unsigned long long storage_limit, int page_size, int channel_num = 1);
    ~MemoryController();
 
 /* ************************************************************************************************
@@ -85,6 +106,8 @@ public:
 
     Page* refer (unsigned long long page_id) {return &mPages[page_id];}
 
+    MemoryChannel* getChannel (int gpu_id) {return &mChannels[gpu_id];}
+
     Page* memoryAllocate (unsigned long long numByte);
 
     void memoryRelease (Page* page);
@@ -111,8 +134,8 @@ private:
     list<Page*> availablePageList;
     list<Page*> usedPageList;
 
-    list<MemoryAccess*> gmmu_to_mc_queue;
-	list<MemoryAccess*> mc_to_gmmu_queue;
+    /* The pages are shared by the GPUs, each GPU accesses its VRAM through its channel */
+    vector<MemoryChannel> mChannels;
 
 friend GMMU;
 };
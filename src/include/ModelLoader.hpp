@@ -0,0 +1,122 @@
+/**
+ * \name    ModelLoader.hpp
+ *
+ * \brief   Declare the loader of the model description file (*.net)
+ *
+ * \note    The description is a list of layers, one layer per statement:
+ *
+ *              Input   shape=3x224x224
+ *              Conv2D  out=64 kernel=7x7 stride=2 padding=3 activation=ReLU
+ *              Pooling kernel=3x3 stride=2 padding=1 activation=Max_Pool
+ *              CaseCode {
+ *                  CaseCade {
+ *                      Conv2D out=64 kernel=3x3 stride=1 padding=1 activation=ReLU
+ *                  }
+ *                  ByPass
+ *              }
+ *              Pooling kernel=global stride=1 activation=Avg_Pool
+ *              Flatten
+ *              Dense   out=1000
+ *
+ *          - \b Input      shape=CxHxW, the input size of the model
+ *          - \b Conv2D     out, kernel, stride (1), padding (0), activation (None)
+ *          - \b Pooling    kernel (global for the whole feature map), stride (1), padding (0), activation (None)
+ *          - \b Dense      out
+ *          - \b Flatten
+ *          - \b ByPass     channel (the input channel), the output channel to concatenate into
+ *          - \b CaseCade   { layers }, the sequential layers
+ *          - \b CaseCode   { layers }, the parallel branches share the same input and output
+ *
+ *          The text after '#' is comment.
+ *
+ * \date    Oct 18, 2026
+ */
+
+#ifndef _MODEL_LOADER_HPP_
+#define _MODEL_LOADER_HPP_
+
+/* ************************************************************************************************
+ * Include Library
+ * ************************************************************************************************
+ */
+#include "App_config.h"
+#include "Log.h"
+
+#include "Layers.hpp"
+#include "LayerGroup.hpp"
+
+
+/** ===============================================================================================
+ * \name    ModelLoader
+ *
+ * \brief   Parse the model description file and build the layer graph. The parsed descriptions are
+ *          cached by the model name, every model instance of an application shares one description.
+ *
+ * \endcond
+ * ================================================================================================
+ */
+class ModelLoader
+{
+/* ************************************************************************************************
+ * Type Define
+ * ************************************************************************************************
+ */
+public:
+    struct LayerDesc {
+        string type;
+        map<string, string> options;
+        vector<LayerDesc> layers;           // the member layers of CaseCade and CaseCode
+        int line;
+    };
+
+/* ************************************************************************************************
+ * Class Constructor
+ * ************************************************************************************************
+ */
+private:
+
+    ModelLoader(const string& model_name, const string& model_path);
+
+/* ************************************************************************************************
+ * Functions
+ * ************************************************************************************************
+ */
+public:
+    static const ModelLoader& load (const string& model_type);
+
+    void buildLayerGraph (LayerGroup* graph, int& layer_id, vector<int> input_size) const;
+
+private:
+    void  parseLayers (const vector<pair<string, int>>& tokens, size_t& index, LayerDesc& group);
+    void  addLayers   (LayerGroup* group, const LayerDesc& desc, int& layer_id, vector<int> input_size) const;
+    Layer* buildLayer (const LayerDesc& desc, int& layer_id, vector<int> input_size) const;
+
+    int         getInt  (const LayerDesc& desc, const string& key, int default_value) const;
+    vector<int> getDims (const LayerDesc& desc, const string& key, vector<int> default_value) const;
+    char*       getName (const LayerDesc& desc, const string& key) const;
+
+/* ************************************************************************************************
+ * Parameter
+ * ************************************************************************************************
+ */
+public:
+    /* The file name without extension */
+    const string name;
+
+    const string path;
+
+    /* [batch, channel, height, width] */
+    vector<int> inputSize;
+
+    /* Hash of the description without comment, to validate the cached profile */
+    size_t signature;
+
+private:
+    LayerDesc root;
+
+    /* Parsed descriptions, indexed by model name, shared by the simulations of all threads */
+    static map<string, ModelLoader> models;
+    static pthread_mutex_t modelsMutex;
+};
+
+#endif
@@ -3,12 +3,14 @@
  * 
  * \brief   Declare the model API 
  *          
- * \note    Available model type:
- *          - \b Test
+ * \note    The model graph is built from the model description (*.net), the available models are
+ *          in MODEL_PATH:
  *          - \b LeNet
+ *          - \b CaffeNet
  *          - \b ResNet18
  *          - \b VGG16
- *          = \b GoogleNet
+ *          - \b GoogleNet
+ *          - \b SqueezeNet
  * 
  * \date    APR 4, 2023
  */
@@ -26,6 +28,7 @@
 #include "Kernel.hpp"
 #include "Layers.hpp"
 #include "LayerGroup.hpp"
+#include "ModelLoader.hpp"
 
 /* ************************************************************************************************
  * Type Define
@@ -112,6 +115,7 @@ public:
     const char* getModelName  (void) {return modelType;}
 
     list<Kernel*> findReadyKernels ();
+    list<Kernel*> findNextKernels ();
     list<Kernel*> getRunningKernels ();
     vector<bool>  getKernelStatus ();
     
@@ -123,6 +127,12 @@ public:
     vector<int> getOFMapSize  (void) const  {return modelGraph->getOFMapSize();}
 
     static ModelInfo getModelInfo (const char* model_type);
+
+private:
+    static ModelInfo deriveModelInfo  (const ModelLoader& model);
+    static void      measureModelInfo (const ModelLoader& model, const string& profile_path);
+    static bool      loadModelInfo    (const string& profile_path, size_t signature, ModelInfo& info);
+    static void      saveModelInfo    (const string& profile_path, size_t signature, const ModelInfo& info);
     
 /* ************************************************************************************************
  * Benchmark
@@ -131,14 +141,6 @@ public:
 public:
     void buildLayerGraph ();
 
-    void LeNet     (vector<int> = {1, 1,  32,  32});
-    void CaffeNet  (vector<int> = {1, 3, 227, 227});
-    void ResNet18  (vector<int> = {1, 3, 224, 224});
-    void VGG16     (vector<int> = {1, 3, 224, 224});
-    // void VGG19  ();
-    void GoogleNet (vector<int> = {1, 3, 224, 224});
-    void SqueezeNet (vector<int> = {1, 3, 224, 224});
-
 /* ************************************************************************************************
  * Parameter
  * ************************************************************************************************
@@ -165,8 +167,14 @@ public:
 
 protected:
 
-    /* Number of layer be created */
-    static int modelCount;
+    /* The model profiles, indexed by model name */
+    static map<string, ModelInfo> modelInfos;
+
+    /* The measurement of the first finished instance of each model, for the profiling simulation */
+    static map<string, ModelInfo> measuredInfos;
+
+    /* The model profiles are shared by the simulations of all threads */
+    static pthread_mutex_t infoMutex;
 
     /* Number of layer */
     int numOfLayer;
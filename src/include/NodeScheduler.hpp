@@ -0,0 +1,72 @@
+/**
+ * \name    NodeScheduler.hpp
+ *
+ * \brief   Declare the node scheduler placing the applications on the GPUs
+ *
+ * \note    The node has command.GPU_NUM GPUs, each with its own SMs, GMMU, VRAM and PCIe link to
+ *          the shared host memory. The applications are placed once before the simulation, each
+ *          GPU is driven by its own CPU scheduler (-S) with the applications placed on it.
+ *
+ * \date    Oct 18, 2026
+ */
+
+#ifndef _NODE_SCHEDULER_HPP_
+#define _NODE_SCHEDULER_HPP_
+
+/* ************************************************************************************************
+ * Include Library
+ * ************************************************************************************************
+ */
+#include "App_config.h"
+#include "Log.h"
+
+#include "Application.hpp"
+
+/** ===============================================================================================
+ * \name    NodeScheduler
+ *
+ * \brief   Create the applications of the task set and place them on the GPUs by
+ *          command.PLACEMENT_MODE
+ *
+ * \endcond
+ * ================================================================================================
+ */
+class NodeScheduler
+{
+/* ************************************************************************************************
+ * Class Constructor
+ * ************************************************************************************************
+ */
+public:
+
+    NodeScheduler(int gpu_num);
+
+/* ************************************************************************************************
+ * Functions
+ * ************************************************************************************************
+ */
+public:
+    /* The CPU of the GPU takes over the applications */
+    const vector<Application*>& getApplications (int gpu_id) {return mPlacement[gpu_id];}
+
+    void printPlacement ();
+
+private:
+    void Placement ();
+
+    unsigned long long getLoad   (Application* app);
+    unsigned long long getMemory (Application* app);
+
+/* ************************************************************************************************
+ * Parameter
+ * ************************************************************************************************
+ */
+private:
+    /* In the order of the task set */
+    vector<Application*> mAPPs;
+
+    /* The applications placed on each GPU */
+    vector<vector<Application*>> mPlacement;
+};
+
+#endif
@@ -20,6 +20,7 @@
 #include "Block.hpp"
 #include "Memory.hpp"
 #include "Warp.hpp"
+#include "WarpScheduler.hpp"
 
 /* ************************************************************************************************
  * Type Define
@@ -50,7 +51,7 @@ class SM
  */ 
 public:
 
-    SM();
+    SM(int sm_id = 0);
 
    ~SM();
 
@@ -70,7 +71,10 @@ struct SMRecord {
 public:
     void cycle ();
 
-    bool bindKernel(Kernel* kernel, int num_of_request);
+    int  admitBlocks(Kernel* kernel);
+    int  idleBlocks(Kernel* kernel);
+    BlockResource getBlockResource(Kernel* kernel);
+    bool bindKernel(Kernel* kernel, int num_of_request, int num_of_block);
     bool terminateKernel (Kernel* kernel);
     void checkBlockFinish();
 
@@ -83,9 +87,13 @@ public:
     SM_Resource getResourceInfo() const {return resource;}
 
 private:
+    static int fitBlocks(const SM_Resource& remaining, const BlockResource& block);
     void recycleResource(Block* block);
     void statistic();
 
+    void issueWarps ();
+    void executeWarp (Block* block, Warp* warp);
+
 /* ************************************************************************************************
  * Parameter
  * ************************************************************************************************
@@ -94,14 +102,15 @@ public:
     const int smID;
 
 private:
-    static int SMCount;
-
     GMMU* mGMMU;
 
     SMRecord record;
 
     map<int, Warp> mWarps;
 
+    /* Empty with UNLIMITED_ISSUE */
+    vector<WarpScheduler> mWarpSchedulers;
+
     SM_Resource resource;
 
     list<Block*> runningBlocks;
@@ -48,6 +48,7 @@ public:
 protected:
     void kernelLauncher (Kernel* kernel);
     void missDeadlineHandler ();
+    void prefetchNextKernels (Kernel* kernel);
 
 /* ************************************************************************************************
  * Parameter
@@ -0,0 +1,106 @@
+/**
+ * \name    SimContext.h
+ *
+ * \brief   Declare the context of a simulation
+ *
+ * \note    The state of a simulation, the cycle, the command, the resource, the hardware profile
+ *          and the index counters of the modules, is kept in its SimContext instead of the global
+ *          variables, so several GPGPU instances can run on different threads of one process. The
+ *          old global names are the members of the context of the calling thread.
+ *
+ *          The thread constructing and running a GPGPU sets sim_context to its own context first,
+ *          the threads created by the simulation (the layer compile threads) inherit the context
+ *          of their creator. The other threads use the main context.
+ *
+ *          The model descriptions (ModelLoader) and the model profiles are immutable after they are
+ *          built, and are shared by all contexts.
+ *
+ * \date    Oct 18, 2026
+ */
+
+#ifndef _SIM_CONTEXT_H_
+#define _SIM_CONTEXT_H_
+
+#include <list>
+#include <string>
+
+#include <pthread.h>
+
+#include "Global.h"
+#include "HardwareConfig.h"
+
+/* ************************************************************************************************
+ * Pre-declaration Class
+ * ************************************************************************************************
+ */
+class LogWriter;
+class TimelineWriter;
+class TraceRecorder;
+
+/* ************************************************************************************************
+ * Type Define
+ * ************************************************************************************************
+ */
+struct SimContext
+{
+    /* Unique among all contexts of the process, the address may be reused by a later context */
+    const unsigned long long contextID;
+
+    unsigned long long cycle = 0;
+
+    Command        cmd;
+    Resource       resource;
+    HardwareConfig hardware;
+    std::string    name;
+
+    /* Thread Protect */
+    pthread_mutex_t io_mutex;
+
+    /* The index counters of the modules */
+    int app_count    = 0;
+    int model_count  = 0;
+    int kernel_count = 0;
+    int block_count  = 0;
+    int va_count     = 0;
+    int memory_count = 0;
+    unsigned long long storage_count;
+
+    /* The writers of the log, --trace-record and --timeline, nullptr if not opened */
+    LogWriter*      log_writer      = nullptr;
+    TraceRecorder*  trace_writer    = nullptr;
+    TimelineWriter* timeline_writer = nullptr;
+
+    /* The statistic shards of the threads of this context and the --stats file, see Statistics.hpp */
+    std::list<unsigned long long*> stats_shards;
+    std::string stats_path;
+    bool stats_csv = false;
+    unsigned long long stats_interval = 0, stats_next_snapshot = 0;
+
+    SimContext ();
+   ~SimContext ();
+
+    SimContext (const SimContext&) = delete;
+    SimContext& operator= (const SimContext&) = delete;
+};
+
+/* ************************************************************************************************
+ * Global variable
+ * ************************************************************************************************
+ */
+/* The context of the GPGPU binary, and the default context of every thread */
+extern SimContext main_context;
+
+/* The context of the calling thread, __thread for the direct access without the TLS wrapper */
+extern __thread SimContext* sim_context;
+
+/* The state of the simulation of the calling thread */
+#define total_gpu_cycle                     (sim_context->cycle)
+#define command                             (sim_context->cmd)
+#define system_resource                     (sim_context->resource)
+#define hardware_config                     (sim_context->hardware)
+#define program_name                        (sim_context->name)
+#define ioMutex                             (&sim_context->io_mutex)
+#define trace_recorder                      (sim_context->trace_writer)
+#define timeline                            (sim_context->timeline_writer)
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ * \name    Statistics.hpp
+ *
+ * \brief   Declare the statistics registry of the named counters and latency histograms
+ *
+ * \note    The counters and histograms are registered once by name and updated through the
+ *          returned handle, the update is an increment of the slot in the shard of the calling
+ *          thread. The shards are merged only when a snapshot is taken.
+ *
+ *          The histogram is log-linear, each power of two is split into STATS_HISTOGRAM_SUB_BUCKET
+ *          linear buckets, the relative error of the reported percentile is below 1/8.
+ *
+ *          The snapshots are appended to --stats file every --stats-interval cycles and at the
+ *          end, one JSON object per line, or one row per value if the file ends with .csv.
+ *
+ *          The statistics are registered once for the process, the shards and the --stats file
+ *          belong to the simulation context, so each simulation reports its own values.
+ *
+ * \date    Oct 18, 2026
+ */
+
+#ifndef _STATISTICS_HPP_
+#define _STATISTICS_HPP_
+
+/* ************************************************************************************************
+ * Include Library
+ * ************************************************************************************************
+ */
+#include "App_config.h"
+#include "Log.h"
+
+/* ************************************************************************************************
+ * Type Define
+ * ************************************************************************************************
+ */
+typedef enum {
+    STATS_COUNTER,
+    STATS_HISTOGRAM,
+} StatsType;
+
+#define STATS_MAX_SLOT                      (1 << 14)                   // slots of a shard
+#define STATS_HISTOGRAM_SUB_BUCKET          8                           // linear buckets of each power of two
+#define STATS_HISTOGRAM_BUCKET              ((64 - 2) * STATS_HISTOGRAM_SUB_BUCKET)
+
+/* The slots of the histogram, followed by the buckets */
+#define STATS_HISTOGRAM_COUNT               0
+#define STATS_HISTOGRAM_SUM                 1
+#define STATS_HISTOGRAM_MAX                 2
+#define STATS_HISTOGRAM_HEADER              3
+
+
+/** ===============================================================================================
+ * \name    Statistics
+ *
+ * \brief   The registry of the statistics, and the handles to update them
+ *
+ * \endcond
+ * ================================================================================================
+ */
+class Statistics
+{
+/* ************************************************************************************************
+ * Class Constructor
+ * ************************************************************************************************
+ */
+private:
+
+    Statistics() {}
+
+/* ************************************************************************************************
+ * Type Define
+ * ************************************************************************************************
+ */
+public:
+/* The handle of a counter */
+struct Counter {
+    size_t slot;
+
+    void add (unsigned long long value = 1) const {Statistics::shard()[slot] += value;}
+};
+
+/* The handle of a histogram */
+struct Histogram {
+    size_t slot;
+
+    void record (unsigned long long value) const
+    {
+        unsigned long long* shard = Statistics::shard() + slot;
+        shard[STATS_HISTOGRAM_COUNT]++;
+        shard[STATS_HISTOGRAM_SUM] += value;
+        shard[STATS_HISTOGRAM_MAX]  = max(shard[STATS_HISTOGRAM_MAX], value);
+        shard[STATS_HISTOGRAM_HEADER + bucket(value)]++;
+    }
+};
+
+private:
+struct Stat {
+    string name;
+    string unit;
+    StatsType type;
+    size_t slot;
+};
+
+/* ************************************************************************************************
+ * Functions
+ * ************************************************************************************************
+ */
+public:
+    static Statistics& instance ();
+
+    Counter   counter   (const string& name, const string& unit = "");
+    Histogram histogram (const string& name, const string& unit = "");
+
+    void open (const string& path, unsigned long long interval);
+    void cycle ();
+    void close ();
+
+    static unsigned long long* shard ()
+    {
+        return (local_shard && local_context == sim_context->contextID) ? local_shard : instance().createShard();
+    }
+
+    /* The bucket of the value and the lower bound of the bucket */
+    static size_t bucket (unsigned long long value)
+    {
+        if (value < STATS_HISTOGRAM_SUB_BUCKET) return value;
+        int exponent = 63 - __builtin_clzll(value);
+        return (exponent - 2) * STATS_HISTOGRAM_SUB_BUCKET + ((value >> (exponent - 3)) & (STATS_HISTOGRAM_SUB_BUCKET - 1));
+    }
+    static unsigned long long bucketLowerBound (size_t index)
+    {
+        if (index < STATS_HISTOGRAM_SUB_BUCKET) return index;
+        return (unsigned long long)(STATS_HISTOGRAM_SUB_BUCKET + index % STATS_HISTOGRAM_SUB_BUCKET) << (index / STATS_HISTOGRAM_SUB_BUCKET - 1);
+    }
+
+private:
+    size_t registerStat (const string& name, const string& unit, StatsType type, size_t num_of_slot);
+    unsigned long long* createShard ();
+
+    vector<unsigned long long> merge ();
+    void snapshot (bool final);
+
+/* ************************************************************************************************
+ * Parameter
+ * ************************************************************************************************
+ */
+private:
+    vector<Stat> stats;
+    size_t num_of_slot = 0;
+
+    /* The shards are kept in SimContext::stats_shards after the thread exits */
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+
+    /* The shard of the calling thread, and the context it belongs to */
+    static thread_local unsigned long long* local_shard;
+    static thread_local unsigned long long  local_context;
+};
+
+#endif
@@ -80,6 +80,26 @@ public:
         return history.size();
     }
 
+    /** ==================================================================
+     * \name    setVictimPreference
+     * 
+     * \brief   prefer the victim satisfying the function among the 
+     *          window least recently used elements, otherwise evict the
+     *          least recently used one
+     * 
+     * \param   prefer_function    the function to determine the element
+     *                             preferred to evict, nullptr for LRU
+     * \param   window             number of elements to scan
+     * 
+     * \endcond
+     * ===================================================================
+     */
+    void setVictimPreference (bool (*prefer_function) (const Value&), unsigned window)
+    {
+        victimPreference = prefer_function;
+        victimWindow = window;
+    }
+
     /** ==================================================================
      * \name    resize
      * 
@@ -162,12 +182,7 @@ public:
         auto it = table.find(key);
         if (it == table.end())
         {
-            if (table.size() == capacity) {
-                auto evict_key = history.front().first;
-                evict_value = history.front().second;
-                history.pop_front();
-                table.erase(evict_key);
-            }
+            if (table.size() == capacity) evict_value = evict();
             
             history.emplace_back(key, value);
             auto it = history.end();
@@ -181,6 +196,47 @@ public:
         return evict_value;
     }
 
+    /** ==================================================================
+     * \name    evict
+     * 
+     * \brief   evict the victim by LRU and victim preference
+     * 
+     * \return  the value be evicted, empty value if the TLB is empty
+     * 
+     * \endcond
+     * ===================================================================
+     */
+    Value evict () 
+    {
+        Value evict_value;
+        if constexpr (std::is_pointer_v<Value>) {
+            evict_value = nullptr;
+        } else {
+            evict_value = Value{};
+        }
+
+        if (history.empty()) return evict_value;
+
+        auto victim = history.begin();
+        if (victimPreference)
+        {
+            auto it = history.begin();
+            for (unsigned i = 0; i < victimWindow && it != history.end(); i++, it++)
+            {
+                if (victimPreference(it->second)) {
+                    victim = it;
+                    break;
+                }
+            }
+        }
+
+        evict_value = victim->second;
+        table.erase(victim->first);
+        history.erase(victim);
+
+        return evict_value;
+    }
+
     /** ==================================================================
      * \name    erase
      * 
@@ -242,6 +298,8 @@ public:
  */
 private:
     unsigned long long capacity;
+    bool (*victimPreference) (const Value&) = nullptr;
+    unsigned victimWindow = 0;
     std::list<std::pair<Key, Value>> history;
     unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator> table;
 };
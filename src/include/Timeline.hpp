@@ -0,0 +1,106 @@
+/**
+ * \name    Timeline.hpp
+ *
+ * \brief   Declare the timeline writer of the kernels, blocks, fault batches and PCIe transfers
+ *
+ * \note    The timeline is written in the Chrome trace-event JSON format, which is opened by
+ *          chrome://tracing or https://ui.perfetto.dev. The events are complete events ("X") with
+ *          the timestamp and duration in us, grouped into the tracks:
+ *
+ *              SM              one track per SM, the blocks
+ *              Application     one track per application, the kernels
+ *              GMMU            the fault batches and the page transfers over PCIe
+ *
+ * \date    Oct 18, 2026
+ */
+
+#ifndef _TIMELINE_HPP_
+#define _TIMELINE_HPP_
+
+/* ************************************************************************************************
+ * Include Library
+ * ************************************************************************************************
+ */
+#include "App_config.h"
+#include "Log.h"
+
+/* ************************************************************************************************
+ * Type Define
+ * ************************************************************************************************
+ */
+typedef enum {
+    TIMELINE_SM,
+    TIMELINE_APPLICATION,
+    TIMELINE_GMMU,
+} TimelineProcess;
+
+typedef enum {
+    TIMELINE_FAULT_BATCH,
+    TIMELINE_PCIE,
+} TimelineGMMUTrack;
+
+#define TIMELINE_BUFFER_SIZE                (1 << 20)                   // unit (Byte), handed to the writer thread when full
+
+
+/** ===============================================================================================
+ * \name    TimelineWriter
+ *
+ * \brief   Buffer the events in memory, the full buffers are written into the file by a background
+ *          thread, so the simulation does not wait for the disk
+ *
+ * \endcond
+ * ================================================================================================
+ */
+class TimelineWriter
+{
+/* ************************************************************************************************
+ * Class Constructor
+ * ************************************************************************************************
+ */
+public:
+
+    TimelineWriter(const string& path);
+
+   ~TimelineWriter();
+
+/* ************************************************************************************************
+ * Functions
+ * ************************************************************************************************
+ */
+public:
+    void recordKernel     (Kernel* kernel, const string& name);
+    void recordFaultBatch (unsigned long long start_cycle, unsigned long long num_of_page);
+    void recordTransfer   (const string& name, int app_id, unsigned long long page_id, double start_cycle);
+
+private:
+    void completeEvent (TimelineProcess pid, int tid, const string& name, double start_cycle, double end_cycle, const string& args);
+    void nameTrack (TimelineProcess pid, int tid, const string& name);
+    void appendEvent (const string& event);
+    void flush ();
+
+    static void* writeThread (void* arg);
+
+/* ************************************************************************************************
+ * Parameter
+ * ************************************************************************************************
+ */
+public:
+    const string path;
+
+private:
+    ofstream file;
+    string buffer;
+    unsigned long long event_count = 0;
+
+    set<pair<int, int>> named_tracks;
+
+    /* The buffers waiting for the writer thread */
+    pthread_t writer;
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    pthread_cond_t  cond  = PTHREAD_COND_INITIALIZER;
+    deque<string> chunks;
+    bool closing = false;
+};
+
+
+#endif
@@ -0,0 +1,236 @@
+/**
+ * \name    Trace.hpp
+ *
+ * \brief   Declare the access trace recorder and the trace replay front end
+ *
+ * \note    The trace is a sequence of records, each starts with a tag byte and the fields are
+ *          unsigned LEB128 varints, the signed deltas are zigzag encoded:
+ *
+ *              header      "GPGPUTRC", version
+ *              r | w       cycle delta, kernel delta, sm, warp, thread, gap, page count, page deltas
+ *              others      cycle delta, finish count, delay, argument count, arguments, page count,
+ *                          page deltas
+ *              Z           cycle delta, finish count, delay, 1, max page id, 0
+ *
+ *          - The gap of the access is the cycles since the previous access of the same thread
+ *            returned, or since the kernel launched for the first access.
+ *          - The control record is gated by the number of the finished kernels and the delay
+ *            since the last of them finished, the replay keeps the kernel dependencies this way.
+ *          - The first page of the access is delta encoded to the first page of the previous
+ *            access, the other pages to the previous page of the access.
+ *
+ * \date    Oct 18, 2026
+ */
+
+#ifndef _TRACE_HPP_
+#define _TRACE_HPP_
+
+/* ************************************************************************************************
+ * Include Library
+ * ************************************************************************************************
+ */
+#include "App_config.h"
+#include "Log.h"
+
+#include "Memory.hpp"
+
+/* ************************************************************************************************
+ * Type Define
+ * ************************************************************************************************
+ */
+typedef enum : char {
+    TRACE_READ          = 'r',
+    TRACE_WRITE         = 'w',
+    TRACE_LAUNCH        = 'K',      // kernel, app, model
+    TRACE_FINISH        = 'F',      // kernel, cycles since the last access of the kernel returned
+    TRACE_CGROUP_SIZE   = 'C',      // app, capacity, limit
+    TRACE_CGROUP_TYPE   = 'I',      // isolation
+    TRACE_CGROUP_FREE   = 'X',      // app
+    TRACE_PREFETCH      = 'P',      // app, priority, pages
+    TRACE_TERMINATE     = 'T',      // app, model
+    TRACE_RELEASE       = 'E',      // pages
+    TRACE_END           = 'Z',      // max page id
+} TraceTag;
+
+#define TRACE_MAGIC                         "GPGPUTRC"
+#define TRACE_VERSION                       1
+#define TRACE_BUFFER_SIZE                   (1 << 20)                   // unit (Byte)
+
+
+/** ===============================================================================================
+ * \name    TraceRecorder
+ *
+ * \brief   Write the accesses leaving the SMs and the GMMU controls into the trace file
+ *
+ * \endcond
+ * ================================================================================================
+ */
+class TraceRecorder
+{
+/* ************************************************************************************************
+ * Class Constructor
+ * ************************************************************************************************
+ */
+public:
+
+    TraceRecorder(const string& path);
+
+   ~TraceRecorder();
+
+/* ************************************************************************************************
+ * Functions
+ * ************************************************************************************************
+ */
+public:
+    void launchKernel (Kernel* kernel);
+    void finishKernel (Kernel* kernel);
+
+    void issueAccess  (MemoryAccess* access);
+    void returnAccess (MemoryAccess* access);
+
+    void recordEvent  (TraceTag tag, const vector<long long>& args, const vector<unsigned long long>& pages = {});
+
+private:
+    void writeVarint (unsigned long long value);
+    void writeSigned (long long value) {writeVarint(((unsigned long long)value << 1) ^ (value >> 63));}
+    void writePages  (const vector<unsigned long long>& pages, unsigned long long& prev_page);
+    void flush ();
+
+/* ************************************************************************************************
+ * Parameter
+ * ************************************************************************************************
+ */
+public:
+    const string path;
+
+private:
+    ofstream file;
+    string buffer;
+
+    unsigned long long last_cycle = 0;
+    unsigned long long finish_count = 0, finish_cycle = 0;
+    unsigned long long max_page = 0;
+    unsigned long long access_count = 0;
+
+    int prev_kernel = 0;
+    unsigned long long prev_page = 0;
+
+    /* The launch cycle and the last return cycle of the running kernels */
+    unordered_map<int, unsigned long long> launch_cycles, kernel_returns;
+
+    /* The last return cycle of each thread, indexed by (sm, warp, thread) */
+    unordered_map<unsigned long long, unsigned long long> thread_returns;
+};
+
+
+/** ===============================================================================================
+ * \name    TraceReplayer
+ *
+ * \brief   Feed the GMMU with the recorded accesses instead of compiling the layers and simulating
+ *          the SMs. Each thread issues its next access by the recorded gap after the previous one
+ *          returns, so the accesses follow the latency of the replayed GMMU and memory controller.
+ *
+ * \endcond
+ * ================================================================================================
+ */
+class TraceReplayer
+{
+/* ************************************************************************************************
+ * Class Constructor
+ * ************************************************************************************************
+ */
+public:
+
+    TraceReplayer(const string& path, GMMU* gmmu, MemoryController* mc);
+
+   ~TraceReplayer();
+
+/* ************************************************************************************************
+ * Type Define
+ * ************************************************************************************************
+ */
+private:
+struct AccessTrace {
+    int kernel_id;
+    int sm_id, warp_id, thread_id;
+    AccessType type;
+    unsigned long long gap;
+    size_t page_offset;
+    unsigned page_count;
+};
+
+struct EventTrace {
+    TraceTag tag;
+    unsigned long long cycle, finish_count, delay;
+    vector<long long> args;
+    vector<unsigned long long> pages;
+};
+
+struct KernelTrace {
+    int app_id = -1, model_id = -1;
+    unsigned long long tail = 0;
+    unsigned long long record_launch = 0, record_finish = 0;
+
+    /* Replay */
+    unsigned long long launch_cycle = 0;
+    unsigned long long remaining = 0;
+    bool terminated = false;
+
+    /* The accesses of each thread in order, indexed by (sm, warp, thread) */
+    map<unsigned long long, deque<size_t>> threads;
+};
+
+/* ************************************************************************************************
+ * Functions
+ * ************************************************************************************************
+ */
+public:
+    void cycle ();
+    void returnAccess (MemoryAccess* access);
+
+    bool isFinish ();
+    unsigned long long nextEventCycle ();
+
+    void printInfo ();
+
+private:
+    void parse (const unsigned char* data, size_t size);
+
+    bool isEventReady (const EventTrace& event);
+    void applyEvent (const EventTrace& event);
+    void launchKernel (int kernel_id, unsigned long long launch_cycle);
+    void issueAccess (size_t index);
+
+/* ************************************************************************************************
+ * Parameter
+ * ************************************************************************************************
+ */
+public:
+    const string path;
+
+private:
+    GMMU* mGMMU;
+    MemoryController* mMC;
+
+    vector<AccessTrace> accesses;
+    vector<unsigned long long> pages;
+    vector<EventTrace> events;
+    map<int, KernelTrace> kernels;
+
+    unsigned long long max_page = 0;
+    unsigned long long record_end_cycle = 0;
+
+    /* Replay */
+    size_t next_event = 0;
+    unsigned long long running_kernels = 0;
+    vector<unsigned long long> finish_cycles = {0};
+
+    priority_queue<pair<unsigned long long, size_t>, vector<pair<unsigned long long, size_t>>, greater<>> ready_accesses;
+    priority_queue<pair<unsigned long long, int>, vector<pair<unsigned long long, int>>, greater<>> finishing_kernels;
+
+    unordered_map<MemoryAccess*, size_t> inflight_accesses;
+    unordered_map<unsigned long long, unsigned long long> thread_returns;
+};
+
+
+#endif
@@ -82,6 +82,9 @@ struct WarpRecord {
  * Functions
  * ************************************************************************************************
  */
+public:
+    /* The warp has threads to compute or to launch the access, not all waiting for the GMMU */
+    bool isReady() const {return isBusy && !busyThreads.empty();}
 
 /* ************************************************************************************************
  * Parameter
@@ -0,0 +1,75 @@
+/**
+ * \name    WarpScheduler.hpp
+ *
+ * \brief   Declare the warp scheduler issuing the ready warps of the SM
+ *
+ * \note    The SM has GPU_WARP_SCHEDULER_PER_SM schedulers, the warp is statically assigned to the
+ *          scheduler (warpID % GPU_WARP_SCHEDULER_PER_SM) and each scheduler issues at most
+ *          GPU_ISSUE_WIDTH ready warps per cycle by command.WARP_SCHEDULER_MODE. The issued warp
+ *          advances its busy threads by one step, a compute instruction or a memory access.
+ *
+ * \date    Oct 18, 2026
+ */
+
+#ifndef _WARP_SCHEDULER_HPP_
+#define _WARP_SCHEDULER_HPP_
+
+/* ************************************************************************************************
+ * Include Library
+ * ************************************************************************************************
+ */
+#include "App_config.h"
+#include "Log.h"
+
+/** ===============================================================================================
+ * \name    WarpScheduler
+ *
+ * \brief   Select the warps issued in the cycle from the busy warps of the scheduler
+ *
+ * \endcond
+ * ================================================================================================
+ */
+class WarpScheduler
+{
+/* ************************************************************************************************
+ * Class Constructor
+ * ************************************************************************************************
+ */
+public:
+
+    WarpScheduler(int scheduler_id = 0) : schedulerID(scheduler_id), trackedWarps(GPU_MAX_WARP_PER_SM, false) {}
+
+/* ************************************************************************************************
+ * Functions
+ * ************************************************************************************************
+ */
+public:
+    /* The warps are the busy warps of the scheduler in the order of warpID */
+    void schedule (const vector<Warp*>& warps, vector<Warp*>& issued);
+
+private:
+    void GTO_Schedule      (const vector<Warp*>& warps, vector<Warp*>& issued);
+    void LRR_Schedule      (const vector<Warp*>& warps, vector<Warp*>& issued);
+    void TwoLevel_Schedule (const vector<Warp*>& warps, vector<Warp*>& issued);
+
+/* ************************************************************************************************
+ * Parameter
+ * ************************************************************************************************
+ */
+public:
+    const int schedulerID;
+
+private:
+    /* GTO: the warp keeps issuing until it stalls */
+    Warp* greedyWarp = nullptr;
+
+    /* LRR: the warp issued last */
+    int lastWarpID = -1;
+
+    /* Two-level: the active warps are issued round robin, the stalled warps wait in the pending warps */
+    list<Warp*> activeWarps;
+    list<Warp*> pendingWarps;
+    vector<bool> trackedWarps;
+};
+
+#endif
@@ -15,11 +15,13 @@
  * Global Variable
  * ************************************************************************************************
  */
-Command command;
-
-Resource system_resource;
-
-string program_name;
+/* The task sets of -T, the other names are the model in MODEL_PATH or the model description file */
+static const map<string, vector<string>> TASK_GROUPS = {
+    {"Light",   {"LeNet", "ResNet18"}},
+    {"Heavy",   {"GoogleNet", "VGG16"}},
+    {"Mix",     {"LeNet", "ResNet18", "GoogleNet", "VGG16"}},
+    {"All",     {"LeNet", "CaffeNet", "ResNet18", "GoogleNet", "VGG16"}},
+};
 
 /* ************************************************************************************************
  * Main
@@ -31,6 +33,9 @@ int main (int argc, char** argv)
 {
     parser_cmd(argc, argv);
 
+    /* Prepare the model profiles, the profiling simulation should run before the GPGPU is built */
+    for (auto& task : command.TASK_LIST) Model::getModelInfo(task.first.c_str());
+
     timeval start, end;
     gettimeofday(&start, NULL);
 
@@ -55,6 +60,17 @@ void parser_cmd (int argc, char** argv)
     string page_num_name =  "-1Pages";
     string scheduler_name = "Baseline";
     string batch_name     = "Max";
+    string option_name    = "";
+    bool   sm_num_set     = false;
+
+    /* Load the hardware profile first, the other arguments depend on it */
+    for (int i = 1; i < argc - 1; i++)
+    {
+        if (string(argv[i]) != "--hw-profile") continue;
+
+        ASSERT(loadHardwareConfig(argv[i + 1]), "Cannot load hardware profile " + string(argv[i + 1]) + ", try --help");
+        option_name += "_" + string(hardware_config.name);
+    }
     
     for (int i = 1; i < argc;)
     {
@@ -93,18 +109,14 @@ void parser_cmd (int argc, char** argv)
                 float deadline     = atof(argv[i++]);
                 auto task_config = make_tuple(batch_size, arrival_time, period, deadline);
                 
-                if (option == "LeNet")          command.TASK_LIST.emplace_back(make_pair(APPLICATION::LeNet,      task_config));
-                else if (option == "CaffeNet")  command.TASK_LIST.emplace_back(make_pair(APPLICATION::CaffeNet,   task_config));
-                else if (option == "ResNet18")  command.TASK_LIST.emplace_back(make_pair(APPLICATION::ResNet18,   task_config));
-                else if (option == "GoogleNet") command.TASK_LIST.emplace_back(make_pair(APPLICATION::GoogleNet,  task_config));
-                else if (option == "VGG16")     command.TASK_LIST.emplace_back(make_pair(APPLICATION::VGG16,      task_config));
-                else if (option == "SqueezeNet")command.TASK_LIST.emplace_back(make_pair(APPLICATION::SqueezeNet, task_config));
-                else if (option == "All")       command.TASK_LIST.emplace_back(make_pair(APPLICATION::ALL,        task_config));
-                else if (option == "Light")     command.TASK_LIST.emplace_back(make_pair(APPLICATION::LIGHT,      task_config));
-                else if (option == "Heavy")     command.TASK_LIST.emplace_back(make_pair(APPLICATION::HEAVY,      task_config));
-                else if (option == "Test1")     command.TASK_LIST.emplace_back(make_pair(APPLICATION::TEST1,      task_config));
-                else if (option == "Test2")     command.TASK_LIST.emplace_back(make_pair(APPLICATION::TEST2,      task_config));
-                else ASSERT(false, "Wrong argument -T, try --help");
+                if (TASK_GROUPS.count(option))
+                {
+                    for (auto& model : TASK_GROUPS.at(option)) command.TASK_LIST.emplace_back(make_pair(model, task_config));
+                }
+                else {
+                    ModelLoader::load(option);
+                    command.TASK_LIST.emplace_back(make_pair(option, task_config));
+                }
             } 
             catch(exception e) ASSERT(false, "Wrong argument -T, try --help");
             
@@ -124,6 +136,7 @@ void parser_cmd (int argc, char** argv)
                 unsigned sm_num = atoi(argv[i++]);
                 if (sm_num > 0) system_resource.SM_NUM = sm_num;
                 sm_num_name = to_string(sm_num) + "SM";
+                sm_num_set  = true;
             } 
             catch(exception e) ASSERT(false, "Wrong argument --sm-num, try --help");
             
@@ -148,20 +161,207 @@ void parser_cmd (int argc, char** argv)
             catch(exception e) ASSERT(false, "Wrong argument --dram-pages, try --help");
             
         }
+        else if (flag == "--gpu-num") 
+        {
+            try{
+                int gpu_num = stoi(argv[i++]);
+                ASSERT(gpu_num > 0, "Wrong argument --gpu-num, try --help");
+                command.GPU_NUM = gpu_num;
+                if (gpu_num > 1) option_name += "_" + to_string(gpu_num) + "GPU";
+            } 
+            catch(exception e) ASSERT(false, "Wrong argument --gpu-num, try --help");
+        }
+        else if (flag == "--placement") 
+        {
+            try{
+                string option = argv[i++];
+                if (option == "round-robin")  command.PLACEMENT_MODE = PLACEMENT::ROUND_ROBIN;
+                else if (option == "load")    command.PLACEMENT_MODE = PLACEMENT::LEAST_LOAD;
+                else if (option == "memory")  command.PLACEMENT_MODE = PLACEMENT::LEAST_MEMORY;
+                else ASSERT(false, "Wrong argument --placement, try --help");
+                if (command.PLACEMENT_MODE == LEAST_LOAD)   option_name += "_Load";
+                if (command.PLACEMENT_MODE == LEAST_MEMORY) option_name += "_Memory";
+            } 
+            catch(exception e) ASSERT(false, "Wrong argument --placement, try --help");
+        }
+        else if (flag == "--peer-link") 
+        {
+            command.PEER_LINK = true;
+            option_name += "_Peer";
+        }
+        else if (flag == "--warp-scheduler") 
+        {
+            try{
+                string option = argv[i++];
+                if (option == "unlimited")      command.WARP_SCHEDULER_MODE = WARP_SCHEDULER::UNLIMITED_ISSUE;
+                else if (option == "gto")       command.WARP_SCHEDULER_MODE = WARP_SCHEDULER::GTO;
+                else if (option == "lrr")       command.WARP_SCHEDULER_MODE = WARP_SCHEDULER::LRR;
+                else if (option == "two-level") command.WARP_SCHEDULER_MODE = WARP_SCHEDULER::TWO_LEVEL;
+                else ASSERT(false, "Wrong argument --warp-scheduler, try --help");
+                if (command.WARP_SCHEDULER_MODE == GTO)       option_name += "_GTO";
+                if (command.WARP_SCHEDULER_MODE == LRR)       option_name += "_LRR";
+                if (command.WARP_SCHEDULER_MODE == TWO_LEVEL) option_name += "_TwoLevel";
+            } 
+            catch(exception e) ASSERT(false, "Wrong argument --warp-scheduler, try --help");
+        }
+        else if (flag == "--occupancy") 
+        {
+            command.OCCUPANCY = true;
+            option_name += "_Occupancy";
+        }
+        else if (flag == "--dispatch") 
+        {
+            try{
+                string option = argv[i++];
+                if (option == "static")           command.DISPATCH_MODE = DISPATCH::STATIC_DISPATCH;
+                else if (option == "incremental") command.DISPATCH_MODE = DISPATCH::INCREMENTAL_DISPATCH;
+                else if (option == "dynamic")     command.DISPATCH_MODE = DISPATCH::DYNAMIC_DISPATCH;
+                else ASSERT(false, "Wrong argument --dispatch, try --help");
+                if (command.DISPATCH_MODE == INCREMENTAL_DISPATCH) option_name += "_Incremental";
+                if (command.DISPATCH_MODE == DYNAMIC_DISPATCH)     option_name += "_Dynamic";
+            } 
+            catch(exception e) ASSERT(false, "Wrong argument --dispatch, try --help");
+        }
+        else if (flag == "--hw-queues") 
+        {
+            try{
+                command.HW_QUEUE_NUM = stoi(argv[i++]);
+                ASSERT(command.HW_QUEUE_NUM >= 0, "Wrong argument --hw-queues, try --help");
+                if (command.HW_QUEUE_NUM > 0) option_name += "_" + to_string(command.HW_QUEUE_NUM) + "HWQ";
+            } 
+            catch(exception e) ASSERT(false, "Wrong argument --hw-queues, try --help");
+        }
+        else if (flag == "--stream-priority") 
+        {
+            try{
+                int app_id = stoi(argv[i++]);
+                int level  = stoi(argv[i++]);
+                ASSERT(app_id >= 0 && level >= 0 && level < STREAM_PRIORITY_LEVEL, "Wrong argument --stream-priority, try --help");
+                command.STREAM_PRIORITY[app_id] = level;
+                option_name += "_" + to_string(app_id) + "P" + to_string(level);
+            } 
+            catch(exception e) ASSERT(false, "Wrong argument --stream-priority, try --help");
+        }
+        else if (flag == "--access-counter") 
+        {
+            try{
+                unsigned long threshold = atol(argv[i++]);
+                command.ACCESS_COUNTER_THRESHOLD = threshold;
+                if (threshold > 0) option_name += "_" + to_string(threshold) + "AC";
+            } 
+            catch(exception e) ASSERT(false, "Wrong argument --access-counter, try --help");
+            
+        }
+        else if (flag == "--hw-profile") 
+        {
+            /* loaded before parsing */
+            i++;
+        }
+        else if (flag == "--prefetch") 
+        {
+            command.PREFETCH_NEXT_KERNEL = true;
+            option_name += "_Prefetch";
+        }
+        else if (flag == "--profile") 
+        {
+            command.PROFILE_EXECUTE_TIME = true;
+        }
+        else if (flag == "--fidelity") 
+        {
+            try{
+                string option = argv[i++];
+                if (option == "cycle")         command.FIDELITY_MODE = FIDELITY::CYCLE;
+                else if (option == "analytic") command.FIDELITY_MODE = FIDELITY::ANALYTIC;
+                else if (option == "sampled")  command.FIDELITY_MODE = FIDELITY::SAMPLED;
+                else ASSERT(false, "Wrong argument --fidelity, try --help");
+                if (command.FIDELITY_MODE == ANALYTIC) option_name += "_Analytic";
+                if (command.FIDELITY_MODE == SAMPLED)  option_name += "_Sampled";
+            } 
+            catch(exception e) ASSERT(false, "Wrong argument --fidelity, try --help");
+        }
+        else if (flag == "--sample-rate") 
+        {
+            try{
+                command.SAMPLE_RATE = stof(argv[i++]);
+                ASSERT(command.SAMPLE_RATE > 0 && command.SAMPLE_RATE <= 1, "Wrong argument --sample-rate, try --help");
+            } 
+            catch(exception e) ASSERT(false, "Wrong argument --sample-rate, try --help");
+        }
+        else if (flag == "--memo") 
+        {
+            try{
+                string option = argv[i++];
+                if (option == "off")         command.MEMO_MODE = MEMOIZATION::NO_MEMO;
+                else if (option == "on")     command.MEMO_MODE = MEMOIZATION::MEMO;
+                else if (option == "strict") command.MEMO_MODE = MEMOIZATION::STRICT_MEMO;
+                else ASSERT(false, "Wrong argument --memo, try --help");
+                if (command.MEMO_MODE != NO_MEMO) option_name += "_Memo";
+            } 
+            catch(exception e) ASSERT(false, "Wrong argument --memo, try --help");
+        }
+        else if (flag == "--trace-record") 
+        {
+            ASSERT(i < argc, "Wrong argument --trace-record, try --help");
+            command.TRACE_RECORD_PATH = argv[i++];
+        }
+        else if (flag == "--trace-replay") 
+        {
+            ASSERT(i < argc, "Wrong argument --trace-replay, try --help");
+            command.TRACE_REPLAY_PATH = argv[i++];
+            option_name += "_Replay";
+        }
+        else if (flag == "--timeline") 
+        {
+            ASSERT(i < argc, "Wrong argument --timeline, try --help");
+            command.TIMELINE_PATH = argv[i++];
+        }
+        else if (flag == "--stats") 
+        {
+            ASSERT(i < argc, "Wrong argument --stats, try --help");
+            command.STATS_PATH = argv[i++];
+        }
+        else if (flag == "--stats-interval") 
+        {
+            try {
+                command.STATS_INTERVAL = stoull(argv[i++]);
+            } 
+            catch(exception e) ASSERT(false, "Wrong argument --stats-interval, try --help");
+        }
         else if (flag == "-h" || flag == "--help") {
             std::cout << "GPGPU: GPGPU [[--sm-num | --vram-pages | -S | -I | -M | -T] [OPTION]]" << std::endl;
 
             std::cout << "Detial:" << std::endl;
             std::cout << "\t  , " << std::left << setw(20) << "--sm-num"           << "[n ∈ N+]" << std::endl;
             std::cout << "\t  , " << std::left << setw(20) << "--vram-pages"       << "[n ∈ N+]" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--gpu-num"          << "[n ∈ N+], the GPUs of the node, each has --sm-num SMs and --vram-pages VRAM" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--placement"        << "round-robin | load | memory, place the applications on the GPUs" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--peer-link"        << "evict the pages into the idle VRAM of the peer GPUs" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--warp-scheduler"   << "unlimited | gto | lrr | two-level, issue the warps by the warp schedulers of the hardware profile" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--occupancy"        << "size the blocks by the registers and shared memory of their layers, pack the kernels into the SMs" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--dispatch"         << "static | incremental | dynamic, bind the blocks of the kernel to its SMs as they admit them" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--hw-queues"        << "[n ∈ N], map the stream of each application onto n hardware queues, 0: the flat command queue" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--stream-priority"  << "[app] [0 - 3], the priority of the stream of the app-th -T, 3 dispatches first" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--access-counter"   << "[n ∈ N], 0: migrate on every fault" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--hw-profile"       << "Xavier | Orin | A100 | [profile file]" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--prefetch"         << "prefetch the filter of next kernel" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--profile"          << "profile the execute time of the models by an isolated simulation" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--fidelity"         << "cycle | analytic | sampled, estimate the kernel duration instead of cycle simulation" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--sample-rate"      << "(0, 1], the fraction of each block simulated by --fidelity sampled (0.1)" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--memo"             << "off | on | strict, replay the recorded duration of the identical kernel launch" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--trace-record"     << "[trace file], record the accesses of the SMs" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--trace-replay"     << "[trace file], replay the accesses on the GMMU without -T" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--stats"            << "[json | csv file], write the counters and histograms at the end" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--stats-interval"   << "[n ∈ N], also write them every n cycles" << std::endl;
+            std::cout << "\t  , " << std::left << setw(20) << "--timeline"         << "[json file], write the kernels, blocks and fault batches for chrome://tracing" << std::endl;
             std::cout << "\t-D, " << std::left << setw(20) << "--deadline"         << "[n ∈ N+]"        << std::endl;
             std::cout << "\t-S, " << std::left << setw(20) << "--scheduler"        << "Baseline | Average | BARM | SALBI" << std::endl;
             std::cout << "\t-B, " << std::left << setw(20) << "--batch-inference"  << "Disable | Max"                         << std::endl;
-            std::cout << "\t-T, " << std::left << setw(20) << "--task-set"         << "LeNet | CaffeNet | ResNet18 | GoogleNet | VGG16 | Light | Heavy | Mix | All | Test1 | Test2"  << std::endl;
+            std::cout << "\t-T, " << std::left << setw(20) << "--task-set"         << "LeNet | CaffeNet | ResNet18 | GoogleNet | VGG16 | SqueezeNet | Light | Heavy | Mix | All | [model.net]"  << std::endl;
 
             std::cout << "Examples:" << std::endl;
             std::cout << "\t./GPGPU -D 1377000000" << std::endl;
             std::cout << "\t./GPGPU -S Baseline -T ResNet18 3 0 -1 -T VGG16 1 0 10 -T GoogleNet 2 0 2 " << std::endl;
+            std::cout << "\t./GPGPU -S Baseline -T ./models/LeNet.net 1 0 -1 100" << std::endl;
             std::cout << "\t./GPGPU -sm-dispatch Baseline -M Average" << std::endl;
 
             std::cout << "Default:" << std::endl;
@@ -171,5 +371,39 @@ void parser_cmd (int argc, char** argv)
         } else ASSERT(false, "Wrong argument, try --help");
     }
 
-    program_name = sm_num_name + "_" + page_num_name + "_" + scheduler_name;
+    /* The analytic model migrates the pages at kernel launch, no page fault handler to overlap with */
+    ASSERT(command.FIDELITY_MODE != ANALYTIC || (!command.PREFETCH_NEXT_KERNEL && !command.ACCESS_COUNTER_THRESHOLD)
+         , "--fidelity analytic does not support --prefetch and --access-counter");
+
+    /* The replayed kernel migrates its pages at launch as the analytic model does */
+    ASSERT(command.MEMO_MODE == NO_MEMO || (command.FIDELITY_MODE != ANALYTIC && !command.ACCESS_COUNTER_THRESHOLD)
+         , "--memo does not support --fidelity analytic and --access-counter");
+
+    /* The trace keeps the accesses of the simulated SMs only */
+    ASSERT(command.TRACE_RECORD_PATH.empty() || (command.FIDELITY_MODE == CYCLE && command.MEMO_MODE == NO_MEMO)
+         , "--trace-record does not support --fidelity and --memo");
+    ASSERT(command.TRACE_REPLAY_PATH.empty() || (command.TASK_LIST.empty() && command.TRACE_RECORD_PATH.empty())
+         , "--trace-replay does not take -T and --trace-record");
+
+    /* The trace and the timeline keep the SMs and the GMMU of one GPU */
+    ASSERT(command.GPU_NUM == 1 || (command.TRACE_RECORD_PATH.empty() && command.TRACE_REPLAY_PATH.empty() && command.TIMELINE_PATH.empty())
+         , "--gpu-num does not support --trace-record, --trace-replay and --timeline");
+    ASSERT(!command.PEER_LINK || (command.GPU_NUM > 1 && PEER_BANDWIDTH > 0)
+         , "--peer-link needs --gpu-num > 1 and the peer_bandwidth of the hardware profile");
+
+    /* The analytic, sampled and replayed kernels hold their SMs as a whole */
+    ASSERT((!command.OCCUPANCY && command.DISPATCH_MODE == STATIC_DISPATCH) || (command.FIDELITY_MODE == CYCLE && command.MEMO_MODE == NO_MEMO)
+         , "--occupancy and --dispatch do not support --fidelity and --memo");
+
+    /* The stream priority is given to the applications of -T */
+    ASSERT(command.STREAM_PRIORITY.empty() || command.STREAM_PRIORITY.rbegin()->first < (int)command.TASK_LIST.size()
+         , "--stream-priority is given to an application not in -T");
+
+    if (!sm_num_set)
+    {
+        system_resource.SM_NUM = hardware_config.sm_num;
+        sm_num_name = to_string(hardware_config.sm_num) + "SM";
+    }
+
+    program_name = sm_num_name + "_" + page_num_name + option_name + "_" + scheduler_name;
 }
\ No newline at end of file
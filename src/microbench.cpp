@@ -0,0 +1,390 @@
+/**
+ * \name    microbench.cpp
+ *
+ * \brief   The microbenchmarks of the hot data structures, run by make microbench
+ *
+ * \note    The benchmarks are built from the simulator classes without the GPGPU:
+ *          - \b tlb            TLB::lookup / insert under the page streams of a CGroup, and resize
+ *          - \b mc             MemoryController::memoryAllocate / memoryRelease of the model buffers
+ *          - \b compress       Kernel::compressRequest of the Conv2D request
+ *          - \b compile        Layer::Compile (Conv2D::issueLayer) of each Conv2D layer of the model
+ *
+ *          Each benchmark runs the warmup repetitions, then the measured repetitions, and reports
+ *          the time per operation of the repetitions by mean and percentiles.
+ *
+ * \date    Oct 18, 2026
+ */
+
+#include "include/App_config.h"
+#include "include/Log.h"
+
+#include "include/Kernel.hpp"
+#include "include/LayerGroup.hpp"
+#include "include/MMU.hpp"
+#include "include/MemoryController.hpp"
+#include "include/ModelLoader.hpp"
+#include "include/TLB.hpp"
+
+#include <chrono>
+#include <functional>
+#include <random>
+
+/* ************************************************************************************************
+ * Software Configuration
+ * ************************************************************************************************
+ */
+#define MICROBENCH_WARMUP           2
+#define MICROBENCH_REPETITION       20
+#define MICROBENCH_TLB_STREAM       (1 << 20)           // accesses of a TLB repetition
+#define MICROBENCH_REQUESTS         1024                // requests of a compress repetition
+
+const vector<unsigned> MICROBENCH_TLB_CAPACITY = {1024, 16384};
+const vector<string>   MICROBENCH_MODELS       = {"LeNet"};
+
+/* ************************************************************************************************
+ * Type Define
+ * ************************************************************************************************
+ */
+struct Option {
+    string filter;
+    int warmup = MICROBENCH_WARMUP;
+    int repetition = MICROBENCH_REPETITION;
+    int batch = 1;
+    vector<string> models = MICROBENCH_MODELS;
+};
+
+/* ************************************************************************************************
+ * Function Declaration
+ * ************************************************************************************************
+ */
+void measure (const string& name, const string& unit, unsigned long long ops, function<void()> setup, function<void()> body);
+string formatTime (double ns);
+
+void benchTLB      ();
+void benchMC       ();
+void benchCompress ();
+void benchCompile  ();
+
+Option option;
+
+
+/** ===============================================================================================
+ * \name    main
+ *
+ * \brief   Run the microbenchmarks
+ *
+ * \param   --filter [text]     run the benchmarks whose name contains the text only
+ * \param   --warmup [n]        the unmeasured repetitions
+ * \param   --reps [n]          the measured repetitions
+ * \param   --model [name]      the model of the mc and compile benchmarks, repeatable
+ * \param   --batch [n]         the batch size of the model
+ *
+ * \endcond
+ * ================================================================================================
+ */
+int main (int argc, char** argv)
+{
+    program_name = "microbench";
+
+    bool model_given = false;
+    for (int i = 1; i < argc; i++)
+    {
+        string flag = argv[i];
+        if (flag == "--filter" && i + 1 < argc)      option.filter     = argv[++i];
+        else if (flag == "--warmup" && i + 1 < argc) option.warmup     = atoi(argv[++i]);
+        else if (flag == "--reps" && i + 1 < argc)   option.repetition = max(1, atoi(argv[++i]));
+        else if (flag == "--batch" && i + 1 < argc)  option.batch      = max(1, atoi(argv[++i]));
+        else if (flag == "--model" && i + 1 < argc)
+        {
+            if (!model_given) option.models.clear();
+            option.models.push_back(argv[++i]);
+            model_given = true;
+        }
+        else
+        {
+            std::cout << "Usage: MICROBENCH [--filter text] [--warmup n] [--reps n] [--model name]... [--batch n]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << std::left << std::setw(44) << "Benchmark" << std::right << std::setw(14) << "Ops"
+              << std::setw(11) << "Mean" << std::setw(11) << "Min" << std::setw(11) << "P50" << std::setw(11) << "P90"
+              << std::setw(11) << "P99" << std::setw(11) << "Max" << "  (per op)" << std::endl;
+
+    benchTLB();
+    benchMC();
+    benchCompress();
+    benchCompile();
+
+    return 0;
+}
+
+
+/** ===============================================================================================
+ * \name    measure
+ *
+ * \brief   Run the benchmark and print the time per operation
+ *
+ * \param   name        the benchmark name, matched with --filter
+ * \param   unit        the operation
+ * \param   ops         the operations of a repetition
+ * \param   setup       the unmeasured preparation before each repetition
+ * \param   body        the measured repetition
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+measure (const string& name, const string& unit, unsigned long long ops, function<void()> setup, function<void()> body)
+{
+    if (name.find(option.filter) == string::npos || ops == 0) return;
+
+    vector<double> samples;
+    for (int i = 0; i < option.warmup + option.repetition; i++)
+    {
+        if (setup) setup();
+
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+
+        if (i >= option.warmup) samples.push_back(std::chrono::duration<double, std::nano>(end - start).count() / ops);
+    }
+
+    /* The percentile is the nearest rank of the sorted samples */
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&samples](double p) {return samples[min(samples.size() - 1, (size_t)max(0.0, ceil(p * samples.size()) - 1))];};
+    double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+
+    std::cout << std::left << std::setw(44) << name << std::right << std::setw(14) << to_string(ops) + " " + unit
+              << std::setw(11) << formatTime(mean) << std::setw(11) << formatTime(samples.front())
+              << std::setw(11) << formatTime(percentile(0.5)) << std::setw(11) << formatTime(percentile(0.9))
+              << std::setw(11) << formatTime(percentile(0.99)) << std::setw(11) << formatTime(samples.back()) << std::endl;
+}
+
+
+/** ===============================================================================================
+ * \name    formatTime
+ *
+ * \brief   Format the nanoseconds by ns, us, ms or s
+ *
+ * \endcond
+ * ================================================================================================
+ */
+string
+formatTime (double ns)
+{
+    const char* units[] = {"ns", "us", "ms", "s"};
+    int unit = 0;
+    for (; unit < 3 && ns >= 1000; unit++) ns /= 1000;
+
+    stringstream buff;
+    buff << std::fixed << std::setprecision(ns < 10 ? 2 : 1) << ns << units[unit];
+    return buff.str();
+}
+
+
+/** ===============================================================================================
+ * \name    benchTLB
+ *
+ * \brief   The CGroup of the GMMU looks up the page of each access and inserts it on miss, the
+ *          streams are generated for a working set twice the capacity:
+ *          - \b seq        the pages are swept in order, every access misses under LRU
+ *          - \b hot        80% of the accesses reuse a quarter of the capacity, the others sweep
+ *          - \b random     the pages are uniformly random
+ *
+ *          The resize shrinks the full TLB to a quarter, the operation is one evicted page.
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+benchTLB ()
+{
+    for (auto capacity : MICROBENCH_TLB_CAPACITY)
+    {
+        unsigned long long working_set = 2 * capacity;
+        vector<Page> pages(working_set);
+
+        std::mt19937_64 generator(capacity);
+        map<string, vector<unsigned long long>> streams;
+        for (unsigned long long i = 0; i < MICROBENCH_TLB_STREAM; i++)
+        {
+            streams["seq"].push_back(i % working_set);
+            streams["hot"].push_back(generator() % 5 < 4 ? generator() % (capacity / 4) : capacity / 4 + i % (working_set - capacity / 4));
+            streams["random"].push_back(generator() % working_set);
+        }
+
+        for (auto& stream : streams)
+        {
+            LRU_TLB<unsigned long long, Page*> tlb(capacity);
+            measure("tlb.access/" + stream.first + "/" + to_string(capacity), "acc", stream.second.size(), nullptr, [&]() {
+                Page* page;
+                for (auto key : stream.second)
+                {
+                    if (!tlb.lookup(key, page)) tlb.insert(key, &pages[key]);
+                }
+            });
+        }
+
+        LRU_TLB<unsigned long long, Page*> tlb(capacity);
+        measure("tlb.resize/" + to_string(capacity), "evict", capacity - capacity / 4, [&]() {
+            tlb.resize(capacity);
+            for (unsigned long long key = 0; key < capacity; key++) tlb.insert(key, &pages[key]);
+        }, [&]() {
+            tlb.resize(capacity / 4);
+        });
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    benchMC
+ *
+ * \brief   Allocate the feature maps and filters of the model, then release them in the same
+ *          order as the layers finish
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+benchMC ()
+{
+    for (auto& model : option.models)
+    {
+        /* The buffers of the layers, indexed by the virtual address */
+        vector<int> input_size = ModelLoader::load(model).inputSize;
+        input_size[BATCH] = option.batch;
+
+        LayerGroup graph;
+        int layer_id = 0;
+        ModelLoader::load(model).buildLayerGraph(&graph, layer_id, input_size);
+
+        vector<Kernel> kernels;
+        kernels.reserve(layer_id);
+        graph.compileToKernel(0, 0, kernels, {});
+
+        map<int, unsigned long long> buffers;
+        unsigned long long num_of_page = 0;
+        for (auto& kernel : kernels)
+        {
+            Layer* layer = kernel.srcLayer;
+            if (layer->getIFMap().second)  buffers[layer->getIFMap().first]  = layer->getIFMapMemory();
+            if (layer->getOFMap().second)  buffers[layer->getOFMap().first]  = layer->getOFMapMemory();
+            if (layer->getFilter().second) buffers[layer->getFilter().first] = layer->getFilterMemory();
+        }
+        for (auto& buffer : buffers) num_of_page += ceil((double)buffer.second / PAGE_SIZE);
+
+        MemoryController mc(system_resource.DRAM_SPACE + system_resource.VRAM_SPACE, PAGE_SIZE);
+        vector<Page*> heads;
+
+        auto allocate = [&]() {for (auto& buffer : buffers) heads.push_back(mc.memoryAllocate(buffer.second));};
+        auto release  = [&]() {for (auto head : heads) mc.memoryRelease(head); heads.clear();};
+
+        string suffix = "/" + model + "/B" + to_string(option.batch);
+        measure("mc.allocate" + suffix, "page", num_of_page, release, allocate);
+        measure("mc.release"  + suffix, "page", num_of_page, [&]() {release(); allocate();}, release);
+        release();
+    }
+}
+
+
+/** ===============================================================================================
+ * \name    benchCompress
+ *
+ * \brief   Compress the request of a 3x3 Conv2D output element, as issued by Conv2D::issueLayer
+ *          with the filter and the 56x56 input feature map of 64 channels
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+benchCompress ()
+{
+    const int channel = 64, height = 56, width = 56, kernel = 3;
+    const unsigned long long filter_page = 1, ifmap_page = 1024, ofmap_page = 8192;
+    const int data_byte = sizeof(DATA_TYPE);
+
+    Request pattern;
+    for (int c_i = 0; c_i < channel; c_i++)
+    {
+        for (int h_i = 0; h_i < kernel; h_i++)
+        {
+            for (int w_i = 0; w_i < kernel; w_i++)
+            {
+                pattern.readPages.emplace_back(filter_page + (c_i * kernel * kernel + h_i * kernel + w_i) * data_byte / PAGE_SIZE, 1);
+                pattern.readPages.emplace_back(ifmap_page + (c_i * height * width + h_i * width + w_i) * data_byte / PAGE_SIZE, 1);
+            }
+        }
+    }
+    pattern.writePages.emplace_back(ofmap_page, 1);
+    pattern.numOfInstructions = kernel * kernel + 1;
+
+    vector<Request*> requests, compressed;
+    auto setup = [&]() {
+        for (auto request : compressed) delete request;
+        compressed.clear();
+        requests.clear();
+        for (int i = 0; i < MICROBENCH_REQUESTS; i++) requests.push_back(new Request(pattern));
+    };
+
+    measure("compress/conv3x3/C" + to_string(channel), "req", MICROBENCH_REQUESTS, setup, [&]() {
+        for (auto request : requests) compressed.push_back(Kernel::compressRequest(request));
+    });
+
+    for (auto request : compressed) delete request;
+}
+
+
+/** ===============================================================================================
+ * \name    benchCompile
+ *
+ * \brief   Compile each Conv2D layer of the model, the buffers are allocated once before the
+ *          warmup and the compiled requests are dropped after each repetition
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void
+benchCompile ()
+{
+    for (auto& model : option.models)
+    {
+        vector<int> input_size = ModelLoader::load(model).inputSize;
+        input_size[BATCH] = option.batch;
+
+        LayerGroup graph;
+        int layer_id = 0;
+        ModelLoader::load(model).buildLayerGraph(&graph, layer_id, input_size);
+
+        vector<Kernel> kernels;
+        kernels.reserve(layer_id);
+        graph.compileToKernel(0, 0, kernels, {});
+
+        MemoryController mc(system_resource.DRAM_SPACE + system_resource.VRAM_SPACE, PAGE_SIZE);
+        MMU mmu(&mc);
+
+        for (auto& kernel : kernels)
+        {
+            Layer* layer = kernel.srcLayer;
+            if (strcmp(layer->layerType, "Conv2D") != 0) continue;
+
+            auto drop = [&kernel]() {
+                while (!kernel.requests.empty())
+                {
+                    delete kernel.requests.front();
+                    kernel.requests.pop();
+                }
+            };
+
+            /* The layer size is [channel, height, width] of the output feature map */
+            vector<int> size = layer->getOFMapSize();
+            string name = "compile/" + model + "/B" + to_string(option.batch) + "/L" + to_string(layer->layerID)
+                        + "_" + to_string(size[CHANNEL]) + "x" + to_string(size[HEIGHT]) + "x" + to_string(size[WIDTH]);
+
+            layer->memoryAllocate(&mmu);
+            measure(name, "layer", 1, drop, [&]() {layer->Compile(&mmu, &kernel);});
+            drop();
+        }
+    }
+}
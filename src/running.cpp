@@ -1,18 +1,38 @@
 /**
  * \name    Running.cpp
- * 
- * \brief   It's a thread running tool
- * 
+ *
+ * \brief   It's a sweep running tool
+ *
+ * \note    The commands of the \b ./taskset_list.txt file are run by a bounded worker pool. Each
+ *          command is keyed by the hash of its configuration, the normalized command and the
+ *          content of the files it refers to (model descriptions, hardware profiles). The finished
+ *          points are appended into SWEEP_PATH/results.jsonl and skipped when the sweep is run
+ *          again, so a crashed or interrupted sweep resumes from the unfinished points.
+ *
+ *          The simulator commands are given --stats SWEEP_PATH/key.stats, the cycle and the
+ *          counters of the final snapshot are collected into SWEEP_PATH/summary.csv.
+ *
  * \date    May 18, 2023
  */
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <vector>
 
-#include <semaphore.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
 
 /* ************************************************************************************************
  * Name Space
@@ -26,83 +46,380 @@ using namespace std;
  */
 #define THREAD_NUM_LIMIT    4
 #define INPUT_FILE          "./taskset_list.txt"
+#define SWEEP_PATH          "./sweep/"
+#define SIMULATOR_NAME      "GPGPU"
+
+/* ************************************************************************************************
+ * Type Define
+ * ************************************************************************************************
+ */
+struct Job {
+    string key;
+    string cmd;
+
+    /* The result */
+    string status = "pending";          // done | failed | timeout
+    int exit_code = 0;
+    double wall_time = 0;               // unit (s)
+    map<string, string> metrics;        // cycle and the counters of the final snapshot
+};
 
 /* ************************************************************************************************
  * Function Declaration
  * ************************************************************************************************
  */
-void exe_thread(string cmd);
+void exe_thread ();
+void runJob (Job& job);
+
+string jobKey (const string& cmd);
+string readResult (const string& line, const string& field);
+map<string, string> readMetrics (const string& path);
+void saveResult (const Job& job);
+void saveSummary ();
 
 /* ************************************************************************************************
  * Global Resource
  * ************************************************************************************************
  */
-sem_t* count_semaphore = new sem_t;
+vector<Job> jobs;
+size_t next_job = 0;
+int timeout = 0;                        // unit (s), 0 for no limit
+
+mutex job_mutex;
 
 /** ===============================================================================================
  * \name    main
- * 
- * \brief   Thread executing the command inside the \b ./taskset_list.txt file
- * 
- * \param   numOfThread    the maximum parallel thread can execute
- * 
+ *
+ * \brief   Run the unfinished commands inside the \b ./taskset_list.txt file
+ *
+ * \param   numOfThread         the maximum parallel thread can execute
+ * \param   --timeout [s]       kill the command after s seconds
+ * \param   --list [file]       the command list instead of ./taskset_list.txt
+ *
  * \note    can ignore the command by add "//" in the start of line
- * 
+ *
  * \endcond
  * ================================================================================================
  */
 int main(int argc, char** argv)
 {
-    vector<string> task_list;
-    
+    int thread_num = THREAD_NUM_LIMIT;
+    string input_file = INPUT_FILE;
+    for (int i = 1; i < argc; i++)
+    {
+        string flag = argv[i];
+        if (flag == "--timeout" && i + 1 < argc)   timeout = atoi(argv[++i]);
+        else if (flag == "--list" && i + 1 < argc) input_file = argv[++i];
+        else if (atoi(argv[i]) > 0)                thread_num = atoi(argv[i]);
+        else {cout << "Usage: RUN [thread_num] [--timeout s] [--list file]\n"; return 1;}
+    }
+
     /* Load the file */
-    fstream file (INPUT_FILE, ios::in);
+    fstream file (input_file, ios::in);
     if (!file.is_open()) {cout << "ERROR Can't open file\n"; abort();}
 
-    /* Parser vaild command */
+    mkdir(SWEEP_PATH, 0755);
+
+    /* The finished points of the previous runs, a torn last line of a crash is ignored */
+    map<string, Job> finished;
+    fstream result_file (SWEEP_PATH "results.jsonl", ios::in);
     string readLine;
+    while (getline(result_file, readLine))
+    {
+        if (readLine.empty() || readLine.back() != '}' || readResult(readLine, "status") != "done") continue;
+
+        Job job;
+        job.key       = readResult(readLine, "key");
+        job.cmd       = readResult(readLine, "cmd");
+        job.status    = "done";
+        job.wall_time = atof(readResult(readLine, "wall_time").c_str());
+        job.metrics   = readMetrics(SWEEP_PATH + job.key + ".stats");
+        finished[job.key] = job;
+    }
+
+    /* Parser vaild command, the same configuration is run once */
+    set<string> keys;
+    int num_of_skip = 0;
     while (getline(file, readLine))
     {
-        if (!(readLine.find("//") == 0 || readLine.empty())) task_list.push_back(readLine);
+        if (readLine.find("//") == 0 || readLine.find_first_not_of(" \t\r") == string::npos) continue;
+
+        Job job;
+        job.cmd = readLine;
+        job.key = jobKey(readLine);
+        if (!keys.insert(job.key).second) continue;
+
+        if (finished.count(job.key))
+        {
+            job = finished[job.key];
+            num_of_skip++;
+        }
+        jobs.push_back(job);
+    }
+
+    cout << "Sweep: " << jobs.size() << " points, " << num_of_skip << " finished, " << thread_num << " workers" << endl;
+
+    /* Launch workers */
+    vector<thread> threads;
+    for (int i = 0; i < thread_num; i++) threads.emplace_back(exe_thread);
+
+    /* Waiting thread finish */
+    for (auto& worker : threads) worker.join();
+
+    saveSummary();
+
+    int num_of_fail = count_if(jobs.begin(), jobs.end(), [](const Job& job) {return job.status != "done";});
+    cout << "Sweep finished: " << jobs.size() - num_of_fail << " done, " << num_of_fail << " failed, summary in " << SWEEP_PATH "summary.csv" << endl;
+    return num_of_fail ? 1 : 0;
+}
+
+
+/** ===============================================================================================
+ * \name    exe_thread
+ *
+ * \brief   The worker takes the next unfinished command until all commands are taken
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void exe_thread()
+{
+    while (1)
+    {
+        job_mutex.lock();
+            while (next_job < jobs.size() && jobs[next_job].status == "done") next_job++;
+            Job* job = next_job < jobs.size() ? &jobs[next_job++] : nullptr;
+            if (job) std::cout << "Exec cmd: [" << job->key << "] " << job->cmd << std::endl;
+        job_mutex.unlock();
+
+        if (!job) return;
+
+        runJob(*job);
+
+        job_mutex.lock();
+            saveResult(*job);
+            std::cout << "Finish: [" << job->key << "] " << job->status << " in " << fixed << setprecision(1) << job->wall_time << "s" << std::endl;
+        job_mutex.unlock();
     }
+}
 
-    /* Determine the parallel ability */
-    int thread_num = (argc > 1) ? atoi(argv[1]) : THREAD_NUM_LIMIT;
-    sem_init(count_semaphore, 0, thread_num);
 
-    /* Launch tasks */
-    thread threads[task_list.size()];
-    for (int i = 0; i < task_list.size(); i++)
+/** ===============================================================================================
+ * \name    runJob
+ *
+ * \brief   Run the command by the shell in its own process group, the group is killed if the
+ *          command exceeds the timeout
+ *
+ * \param   job     the command, filled with the result
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void runJob (Job& job)
+{
+    string stats_path = SWEEP_PATH + job.key + ".stats";
+    string output_path = SWEEP_PATH + job.key + ".out";
+
+    string cmd = job.cmd;
+    if (cmd.find(SIMULATOR_NAME) != string::npos && cmd.find("--stats") == string::npos) cmd += " --stats " + stats_path;
+    unlink(stats_path.c_str());
+
+    auto start = chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid == 0)
     {
-        threads[i] = thread(exe_thread, task_list.at(i));
+        setpgid(0, 0);
+
+        int output_fd = open(output_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        dup2(output_fd, STDOUT_FILENO);
+        dup2(output_fd, STDERR_FILENO);
+
+        execl("/bin/sh", "sh", "-c", cmd.c_str(), (char*)nullptr);
+        _exit(127);
     }
 
-    /* Waiting thread finish */
-    for (int i = 0; i < task_list.size(); i++)
+    int status = 0;
+    bool killed = false;
+    while (pid > 0 && waitpid(pid, &status, WNOHANG) == 0)
     {
-        threads[i].join();
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (timeout && elapsed > timeout && !killed)
+        {
+            kill(-pid, SIGKILL);
+            killed = true;
+        }
+        this_thread::sleep_for(chrono::milliseconds(50));
     }
-    
-    sem_destroy(count_semaphore);
+
+    job.wall_time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    job.exit_code = (pid > 0 && WIFEXITED(status)) ? WEXITSTATUS(status) : -1;
+    job.status    = killed ? "timeout" : (job.exit_code == 0 ? "done" : "failed");
+    job.metrics   = readMetrics(stats_path);
 }
 
 
 /** ===============================================================================================
- * \name    exe_thread
- * 
- * \brief   Thread executing the command once the thread pend the semaphore
- * 
- * \param   cmd    the command going to execute
- * 
+ * \name    jobKey
+ *
+ * \brief   Hash the configuration of the command by FNV-1a, the hash is stable across builds
+ *
+ * \param   cmd     the command
+ *
+ * \return  the key in hexadecimal
+ *
  * \endcond
  * ================================================================================================
  */
-void exe_thread(string cmd)
+string jobKey (const string& cmd)
 {
-    sem_wait(count_semaphore);
-        std::cout << "Exec cmd: " << cmd << std::endl;
-        int ret = system(cmd.c_str());
-    sem_post(count_semaphore);
+    unsigned long long hash = 14695981039346656037ULL;
+    auto update = [&hash](const string& text) {
+        for (unsigned char c : text) hash = (hash ^ c) * 1099511628211ULL;
+        hash = (hash ^ 0xff) * 1099511628211ULL;
+    };
+
+    /* The arguments, and the content of the arguments which are files */
+    stringstream tokens(cmd);
+    string token;
+    bool first = true;
+    while (tokens >> token)
+    {
+        update(token);
+
+        struct stat info;
+        if (!first && stat(token.c_str(), &info) == 0 && S_ISREG(info.st_mode))
+        {
+            ifstream file(token);
+            update(string(istreambuf_iterator<char>(file), istreambuf_iterator<char>()));
+        }
+        first = false;
+    }
 
-    std::cout << "Finish: " << cmd << std::endl;
+    stringstream buff;
+    buff << hex << setw(16) << setfill('0') << hash;
+    return buff.str();
+}
+
+
+/** ===============================================================================================
+ * \name    readResult
+ *
+ * \brief   Read the string or number of the field in the result line
+ *
+ * \endcond
+ * ================================================================================================
+ */
+string readResult (const string& line, const string& field)
+{
+    auto pos = line.find("\"" + field + "\":");
+    if (pos == string::npos) return "";
+    pos += field.size() + 3;
+
+    if (line[pos] != '"') return line.substr(pos, line.find_first_of(",}", pos) - pos);
+
+    /* The string with the escaped characters */
+    string value;
+    for (pos++; pos < line.size() && line[pos] != '"'; pos++)
+    {
+        if (line[pos] == '\\' && pos + 1 < line.size()) pos++;
+        value += line[pos];
+    }
+    return value;
+}
+
+
+/** ===============================================================================================
+ * \name    readMetrics
+ *
+ * \brief   Read the cycle and the counters of the final snapshot of the statistic file
+ *
+ * \endcond
+ * ================================================================================================
+ */
+map<string, string> readMetrics (const string& path)
+{
+    map<string, string> metrics;
+
+    ifstream file(path);
+    string line, last;
+    while (getline(file, line)) if (!line.empty()) last = line;
+    if (last.find("\"final\":true") == string::npos) return metrics;
+
+    metrics["cycle"] = readResult(last, "cycle");
+
+    auto pos = last.find("\"counters\":{");
+    if (pos == string::npos) return metrics;
+
+    /* "name":value pairs until the end of the object */
+    for (pos += 12; pos < last.size() && last[pos] == '"';)
+    {
+        auto name_end = last.find('"', pos + 1);
+        auto value_end = last.find_first_of(",}", name_end);
+        metrics[last.substr(pos + 1, name_end - pos - 1)] = last.substr(name_end + 2, value_end - name_end - 2);
+
+        if (last[value_end] == '}') break;
+        pos = value_end + 1;
+    }
+
+    return metrics;
+}
+
+
+/** ===============================================================================================
+ * \name    saveResult
+ *
+ * \brief   Append the result of the command, flushed to the disk before the next command is taken
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void saveResult (const Job& job)
+{
+    string cmd;
+    for (char c : job.cmd)
+    {
+        if (c == '"' || c == '\\') cmd += '\\';
+        cmd += c;
+    }
+
+    stringstream buff;
+    buff << "{\"key\":\"" << job.key << "\",\"cmd\":\"" << cmd << "\",\"status\":\"" << job.status << "\",\"exit_code\":" << job.exit_code
+         << ",\"wall_time\":" << fixed << setprecision(3) << job.wall_time << ",\"cycle\":" << (job.metrics.count("cycle") ? job.metrics.at("cycle") : "0") << "}\n";
+
+    int fd = open(SWEEP_PATH "results.jsonl", O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) return;
+
+    string line = buff.str();
+    ssize_t ret = write(fd, line.data(), line.size());
+    fsync(fd);
+    close(fd);
+}
+
+
+/** ===============================================================================================
+ * \name    saveSummary
+ *
+ * \brief   Write the table of all points, one column per metric of any point
+ *
+ * \endcond
+ * ================================================================================================
+ */
+void saveSummary ()
+{
+    set<string> columns;
+    for (auto& job : jobs) for (auto& metric : job.metrics) columns.insert(metric.first);
+
+    ofstream file(SWEEP_PATH "summary.csv", ios::out | ios::trunc);
+    file << "key,status,wall_time";
+    for (auto& column : columns) file << "," << column;
+    file << ",cmd" << endl;
+
+    for (auto& job : jobs)
+    {
+        file << job.key << "," << job.status << "," << fixed << setprecision(3) << job.wall_time;
+        for (auto& column : columns) file << "," << (job.metrics.count(column) ? job.metrics.at(column) : "");
+        string cmd;
+        for (char c : job.cmd) cmd += (c == '"') ? string("\"\"") : string(1, c);
+        file << ",\"" << cmd << "\"" << endl;
+    }
 }